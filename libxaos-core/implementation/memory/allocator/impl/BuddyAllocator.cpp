@@ -0,0 +1,337 @@
+/**
+ *  @file BuddyAllocator.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/BuddyAllocator.h
+ *
+ *  This file provides implementations for the BuddyAllocator class.
+ *
+ *  Blocks are identified by their order and their index within that order
+ *  (their offset divided by their size).  A block's buddy is at index ^ 1
+ *  and its parent at index >> 1.  Both bitmaps hold every order back to back
+ *  starting with order zero (see _bitOffsets).
+ *
+ *  An allocated block's order isn't stored anywhere.  Every ancestor of a
+ *  used block is split, but the block itself (and everything inside it) is
+ *  not, so its order is one less than that of its lowest split ancestor.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "memory/allocator/impl/BuddyAllocator.h"
+#include "memory/store/IStore.h"
+#include "memory/utility/alignment.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        constexpr const size_t BuddyAllocator::DEFAULT_MIN_BLOCK_SIZE;
+        constexpr const size_t BuddyAllocator::MAX_ORDER_COUNT;
+
+        // Helpers!  Only visible here.
+        namespace {
+            constexpr size_t BITS_PER_WORD = sizeof(uint64_t) * 8;
+
+            // Bit Scanning
+            inline size_t findFirstSet(uint64_t word) {
+                assert(word != 0);
+                #if defined(_MSC_VER) && defined(_WIN64)
+                    unsigned long index;
+                    _BitScanForward64(&index, word);
+                    return index;
+                #elif defined(_MSC_VER)
+                    unsigned long index;
+                    if (_BitScanForward(&index,
+                            static_cast<unsigned long>(word)))
+                        return index;
+                    _BitScanForward(&index,
+                            static_cast<unsigned long>(word >> 32));
+                    return index + 32;
+                #else
+                    return static_cast<size_t>(__builtin_ctzll(word));
+                #endif
+            }
+            inline size_t findLastSet(uint64_t word) {
+                assert(word != 0);
+                #if defined(_MSC_VER) && defined(_WIN64)
+                    unsigned long index;
+                    _BitScanReverse64(&index, word);
+                    return index;
+                #elif defined(_MSC_VER)
+                    unsigned long index;
+                    if (_BitScanReverse(&index,
+                            static_cast<unsigned long>(word >> 32)))
+                        return index + 32;
+                    _BitScanReverse(&index, static_cast<unsigned long>(word));
+                    return index;
+                #else
+                    return BITS_PER_WORD - 1 -
+                            static_cast<size_t>(__builtin_clzll(word));
+                #endif
+            }
+
+            // Rounds up to a power of two (which must fit).
+            inline size_t roundUpToPowerOfTwo(size_t value) {
+                return value <= 1 ? 1 :
+                        size_t(1) << (findLastSet(value - 1) + 1);
+            }
+        }
+
+        // Constructors
+        BuddyAllocator::BuddyAllocator(IStore* store, size_t minBlockSize) :
+                _store(store), _begin(nullptr), _alignment(0), _capacity(0),
+                _minBlockSize(minBlockSize), _minBlockShift(0), _orderCount(0),
+                _freeBits(nullptr), _splitBits(nullptr), _bitOffsets(),
+                _freeLists(), _freeCounts(), _nonEmpty(0), _usedBytes(0),
+                _allocationCount(0), _tag(MEMORY_TAG_UNTAGGED) {
+            assert(isPowerOfTwo(minBlockSize)); // Blocks must split evenly!
+            assert(minBlockSize >= sizeof(FreeBlock)); // Must hold links!
+            if (!_store || !_store->commit(_store->SIZE))
+                return;
+
+            // Blocks start max_align_t aligned (if they're that big), even
+            // in stores with a smaller ALIGNMENT.
+            _minBlockShift = findLastSet(minBlockSize);
+            uint8_t* raw = _store->getRawStorage();
+            size_t alignment = minBlockSize < alignof(std::max_align_t) ?
+                    minBlockSize : alignof(std::max_align_t);
+            size_t padding = getAlignmentOffset(raw, alignment);
+            if (padding >= _store->SIZE)
+                return;
+            raw += padding;
+            size_t size = _store->SIZE - padding;
+
+            // Reserve room for bitmaps covering every block in the store,
+            // then carve blocks out of whatever is left.
+            size_t blocks = roundUpToPowerOfTwo(size >> _minBlockShift);
+            size_t words = (2 * blocks + BITS_PER_WORD - 1) / BITS_PER_WORD;
+            size_t bitmapBytes = 2 * words * sizeof(uint64_t) +
+                    alignof(uint64_t);
+            if (bitmapBytes + minBlockSize > size)
+                return;
+
+            uint8_t* bitmaps = alignDown(raw + size - bitmapBytes +
+                    alignof(uint64_t), alignof(uint64_t));
+            size_t usable = static_cast<size_t>(bitmaps - raw) >>
+                    _minBlockShift;
+            blocks = roundUpToPowerOfTwo(usable);
+            _orderCount = findLastSet(blocks) + 1;
+            assert(_orderCount <= MAX_ORDER_COUNT);
+
+            // Lay out the (now smaller) bitmaps.
+            size_t totalBits = 0;
+            for (size_t order = 0; order < _orderCount; order++) {
+                _bitOffsets[order] = totalBits;
+                totalBits += blocks >> order;
+            }
+            words = (totalBits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+            _freeBits = reinterpret_cast<uint64_t*>(bitmaps);
+            _splitBits = _freeBits + words;
+            memset(_freeBits, 0, 2 * words * sizeof(uint64_t));
+
+            _begin = raw;
+            _alignment = alignment > _store->ALIGNMENT ?
+                    alignment : _store->ALIGNMENT;
+            _capacity = usable << _minBlockShift;
+
+            // Carve the largest blocks that fit, largest first (so each one
+            // is aligned to its size).  Their ancestors are all "split";
+            // they can never merge with the blocks past the end.
+            size_t offset = 0;
+            for (size_t order = _orderCount; order-- > 0; ) {
+                if (usable - offset < (size_t(1) << order))
+                    continue;
+
+                pushFree(order, offset >> order);
+                for (size_t parent = order + 1; parent < _orderCount;
+                        parent++) {
+                    setBit(_splitBits, parent, offset >> parent, true);
+                }
+                offset += size_t(1) << order;
+            }
+        }
+        BuddyAllocator::~BuddyAllocator() {
+            recordDeallocation(_tag, _usedBytes, _allocationCount);
+            if (_store)
+                delete _store;
+        }
+
+        // Bitmaps
+        bool BuddyAllocator::testBit(const uint64_t* bits, size_t order,
+                size_t index) const {
+            size_t bit = _bitOffsets[order] + index;
+            return (bits[bit / BITS_PER_WORD] >> (bit % BITS_PER_WORD)) & 1;
+        }
+        void BuddyAllocator::setBit(uint64_t* bits, size_t order, size_t index,
+                bool value) {
+            size_t bit = _bitOffsets[order] + index;
+            uint64_t mask = uint64_t(1) << (bit % BITS_PER_WORD);
+            if (value)
+                bits[bit / BITS_PER_WORD] |= mask;
+            else
+                bits[bit / BITS_PER_WORD] &= ~mask;
+        }
+
+        // Free List Management
+        void BuddyAllocator::pushFree(size_t order, size_t index) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(_begin +
+                    (index << (order + _minBlockShift)));
+            block->previous = nullptr;
+            block->next = _freeLists[order];
+            if (block->next)
+                block->next->previous = block;
+            _freeLists[order] = block;
+            _freeCounts[order]++;
+            _nonEmpty |= uint64_t(1) << order;
+            setBit(_freeBits, order, index, true);
+        }
+        void BuddyAllocator::removeFree(FreeBlock* block, size_t order,
+                size_t index) {
+            if (block->previous)
+                block->previous->next = block->next;
+            else
+                _freeLists[order] = block->next;
+            if (block->next)
+                block->next->previous = block->previous;
+
+            if (--_freeCounts[order] == 0)
+                _nonEmpty &= ~(uint64_t(1) << order);
+            setBit(_freeBits, order, index, false);
+        }
+
+        // Tree Queries
+        size_t BuddyAllocator::getOrder(size_t offset) const {
+            size_t block = offset >> _minBlockShift;
+            size_t order = 0;
+            while (order + 1 < _orderCount &&
+                    !testBit(_splitBits, order + 1, block >> (order + 1))) {
+                order++;
+            }
+            return order;
+        }
+
+        // Allocation
+        void* BuddyAllocator::allocate(size_t size, size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+
+            // Blocks are aligned to their size (up to the first block's).
+            if (_begin == nullptr || alignment > _alignment) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+            size_t rounded = size > alignment ? size : alignment;
+            size_t order = rounded <= _minBlockSize ? 0 :
+                    findLastSet((rounded - 1) >> _minBlockShift) + 1;
+
+            uint64_t candidates = order < _orderCount ?
+                    _nonEmpty & (~uint64_t(0) << order) : 0;
+            if (candidates == 0) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            // Take the smallest block that fits and split it down.
+            size_t current = findFirstSet(candidates);
+            FreeBlock* block = _freeLists[current];
+            size_t index = static_cast<size_t>(reinterpret_cast<uint8_t*>(
+                    block) - _begin) >> (current + _minBlockShift);
+            removeFree(block, current, index);
+            while (current > order) {
+                setBit(_splitBits, current, index, true);
+                current--;
+                index <<= 1;
+                pushFree(current, index | 1);
+            }
+
+            size_t blockSize = _minBlockSize << order;
+            _usedBytes += blockSize;
+            _allocationCount++;
+            recordAllocation(_tag, blockSize);
+            return block;
+        }
+        void BuddyAllocator::deallocate(void* pointer) {
+            if (pointer == nullptr)
+                return;
+
+            assert(owns(pointer)); // Not one of ours!
+            size_t offset = static_cast<size_t>(
+                    static_cast<uint8_t*>(pointer) - _begin);
+            size_t order = getOrder(offset);
+            size_t index = offset >> (order + _minBlockShift);
+            assert((index << (order + _minBlockShift)) == offset); // Middle?
+            assert(!testBit(_freeBits, order, index)); // Double free?
+
+            size_t blockSize = _minBlockSize << order;
+            _usedBytes -= blockSize;
+            _allocationCount--;
+            recordDeallocation(_tag, blockSize);
+
+            // Merge with our buddy for as long as it's free.
+            while (order + 1 < _orderCount &&
+                    testBit(_freeBits, order, index ^ 1)) {
+                size_t buddy = index ^ 1;
+                removeFree(reinterpret_cast<FreeBlock*>(_begin +
+                        (buddy << (order + _minBlockShift))), order, buddy);
+                index >>= 1;
+                order++;
+                setBit(_splitBits, order, index, false);
+            }
+            pushFree(order, index);
+        }
+
+        // Queries
+        bool BuddyAllocator::owns(const void* pointer) const {
+            const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+            return _begin != nullptr && bytes >= _begin &&
+                    bytes < _begin + _capacity;
+        }
+        size_t BuddyAllocator::getAllocationSize(const void* pointer) const {
+            if (pointer == nullptr)
+                return 0;
+            return _minBlockSize << getOrder(static_cast<size_t>(
+                    static_cast<const uint8_t*>(pointer) - _begin));
+        }
+        size_t BuddyAllocator::getMinBlockSize() const {
+            return _minBlockSize;
+        }
+        size_t BuddyAllocator::getOrderCount() const {
+            return _orderCount;
+        }
+        size_t BuddyAllocator::getFreeBlockCount(size_t order) const {
+            assert(order < MAX_ORDER_COUNT);
+            return _freeCounts[order];
+        }
+        BuddyAllocator::Statistics BuddyAllocator::getStatistics() const {
+            Statistics statistics {_usedBytes, _capacity - _usedBytes, 0,
+                    _allocationCount, 0, 0.0};
+
+            for (size_t order = 0; order < _orderCount; order++) {
+                statistics.freeBlockCount += _freeCounts[order];
+            }
+            if (_nonEmpty != 0) {
+                statistics.largestFreeBlock =
+                        _minBlockSize << findLastSet(_nonEmpty);
+            }
+            if (statistics.freeBytes != 0) {
+                statistics.fragmentation = 1.0 -
+                        static_cast<double>(statistics.largestFreeBlock) /
+                        static_cast<double>(statistics.freeBytes);
+            }
+            return statistics;
+        }
+
+        // Tracking
+        void BuddyAllocator::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        MemoryTag BuddyAllocator::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
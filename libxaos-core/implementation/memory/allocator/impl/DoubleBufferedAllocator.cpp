@@ -0,0 +1,45 @@
+/**
+ *  @file DoubleBufferedAllocator.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/DoubleBufferedAllocator.h
+ *
+ *  This file provides implementations for the DoubleBufferedAllocator class.
+ */
+
+#include <utility>
+
+#include "memory/allocator/impl/DoubleBufferedAllocator.h"
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        constexpr const size_t DoubleBufferedAllocator::DEFAULT_ALIGNMENT;
+
+        // Constructors
+        DoubleBufferedAllocator::DoubleBufferedAllocator(IStore* first,
+                IStore* second) : _buffers {{first}, {second}}, _current(0),
+                _frame(0) {}
+        DoubleBufferedAllocator::~DoubleBufferedAllocator() {}
+
+        // Move Semantics (no copying allocators!)
+        DoubleBufferedAllocator::DoubleBufferedAllocator(
+                DoubleBufferedAllocator&& other) :
+                _buffers {std::move(other._buffers[0]),
+                std::move(other._buffers[1])},
+                _current(other._current), _frame(other._frame) {
+            other._current = 0;
+            other._frame = 0;
+        }
+        DoubleBufferedAllocator& DoubleBufferedAllocator::operator=(
+                DoubleBufferedAllocator&& other) {
+            if (this != &other) {
+                _buffers[0] = std::move(other._buffers[0]);
+                _buffers[1] = std::move(other._buffers[1]);
+                std::swap(_current, other._current);
+                std::swap(_frame, other._frame);
+            }
+            return *this;
+        }
+    }
+}
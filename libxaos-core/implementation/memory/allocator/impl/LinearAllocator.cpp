@@ -0,0 +1,63 @@
+/**
+ *  @file LinearAllocator.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/LinearAllocator.h
+ *
+ *  This file provides implementations for the LinearAllocator class.
+ */
+
+#include <utility>
+
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        constexpr const size_t LinearAllocator::DEFAULT_ALIGNMENT;
+
+        // Constructors
+        LinearAllocator::LinearAllocator(IStore* store) : _store(store),
+                _begin(store ? store->getRawStorage() : nullptr),
+                _capacity(store ? store->SIZE : 0),
+                _committed(store ? store->getCommitted() : 0), _offset(0),
+                _tag(MEMORY_TAG_UNTAGGED) {}
+        LinearAllocator::~LinearAllocator() {
+            recordDeallocation(_tag, _offset, 0);
+            if (_store)
+                delete _store;
+        }
+
+        // Move Semantics (no copying allocators!)
+        LinearAllocator::LinearAllocator(LinearAllocator&& other) :
+                _store(other._store), _begin(other._begin),
+                _capacity(other._capacity), _committed(other._committed),
+                _offset(other._offset), _tag(other._tag) {
+            other._store = nullptr;
+            other._begin = nullptr;
+            other._capacity = 0;
+            other._committed = 0;
+            other._offset = 0;
+        }
+        LinearAllocator& LinearAllocator::operator=(LinearAllocator&& other) {
+            if (this != &other) {
+                std::swap(_store, other._store);
+                std::swap(_begin, other._begin);
+                std::swap(_capacity, other._capacity);
+                std::swap(_committed, other._committed);
+                std::swap(_offset, other._offset);
+                std::swap(_tag, other._tag);
+            }
+            return *this;
+        }
+
+        // Growth - the slow path.
+        bool LinearAllocator::grow(size_t size) {
+            if (!_store->commit(size))
+                return false;
+
+            _committed = _store->getCommitted();
+            return true;
+        }
+    }
+}
@@ -0,0 +1,302 @@
+/**
+ *  @file RelocatableHeap.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/RelocatableHeap.h
+ *
+ *  This file provides implementations for the RelocatableHeap class.
+ *
+ *  Blocks are laid out back to back from the start of the store, each with a
+ *  header recording its size and the handle that owns it (or FREE_HANDLE).
+ *  New blocks are bumped off the top when there's room, otherwise they go in
+ *  the first hole that fits.  Adjacent free blocks are merged lazily, as
+ *  they're walked over.
+ *
+ *  defragment() is a sliding compactor.  Everything below _compactFrom is
+ *  known to be packed; each step merges the hole there and swaps it with the
+ *  used block just past it.
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "memory/allocator/impl/RelocatableHeap.h"
+#include "memory/store/IStore.h"
+#include "memory/utility/alignment.h"
+#include "timing/Clock.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        constexpr const size_t RelocatableHeap::ALIGNMENT;
+        constexpr const size_t RelocatableHeap::DEFAULT_MAX_HANDLES;
+
+        // Helpers!  Only visible here.
+        namespace {
+            //! Marks free blocks (and the end of the handle free list).
+            constexpr uint32_t FREE_HANDLE = UINT32_MAX;
+            //! Marks handle entries that are in use.
+            constexpr uint32_t USED_HANDLE = UINT32_MAX - 1;
+        }
+
+        // Constructors
+        RelocatableHeap::RelocatableHeap(IStore* store, size_t maxHandles) :
+                _store(store), _begin(nullptr), _capacity(0), _top(0),
+                _compactFrom(0), _holeBytes(0), _usedBytes(0),
+                _handles(nullptr), _handleCapacity(0),
+                _freeHandle(FREE_HANDLE), _handleCount(0),
+                _tag(MEMORY_TAG_UNTAGGED) {
+            assert(maxHandles > 0 && maxHandles < USED_HANDLE);
+            if (!_store || !_store->commit(_store->SIZE))
+                return;
+
+            // Blocks at the front (aligned), handles at the back.
+            uint8_t* raw = _store->getRawStorage();
+            uint8_t* end = raw + _store->SIZE;
+            uint8_t* begin = alignUp(raw, ALIGNMENT);
+            size_t tableBytes = maxHandles * sizeof(HandleEntry) +
+                    alignof(HandleEntry);
+            if (begin > end || static_cast<size_t>(end - begin) <=
+                    tableBytes + ALIGNMENT)
+                return;
+
+            uint8_t* table = alignDown(end - maxHandles * sizeof(HandleEntry),
+                    alignof(HandleEntry));
+            _begin = begin;
+            _capacity = alignDown(static_cast<size_t>(table - begin),
+                    ALIGNMENT);
+            _handles = reinterpret_cast<HandleEntry*>(table);
+            _handleCapacity = maxHandles;
+
+            // Thread every entry onto the free list.
+            for (size_t i = 0; i < maxHandles; i++) {
+                _handles[i].offset = 0;
+                _handles[i].generation = 1;
+                _handles[i].nextFree = i + 1 < maxHandles ?
+                        static_cast<uint32_t>(i + 1) : FREE_HANDLE;
+            }
+            _freeHandle = 0;
+        }
+        RelocatableHeap::~RelocatableHeap() {
+            recordDeallocation(_tag, _usedBytes, _handleCount);
+            if (_store)
+                delete _store;
+        }
+
+        // Helpers
+        RelocatableHeap::BlockHeader* RelocatableHeap::getBlock(
+                size_t offset) const {
+            return reinterpret_cast<BlockHeader*>(_begin + offset);
+        }
+        RelocatableHeap::HandleEntry* RelocatableHeap::getEntry(
+                Handle handle) const {
+            if (handle.index >= _handleCapacity)
+                return nullptr;
+
+            HandleEntry* entry = _handles + handle.index;
+            if (entry->generation != handle.generation ||
+                    entry->nextFree != USED_HANDLE)
+                return nullptr;
+            return entry;
+        }
+        size_t RelocatableHeap::findHole(size_t size) {
+            size_t offset = _compactFrom;
+            while (offset < _top) {
+                BlockHeader* block = getBlock(offset);
+                if (block->handle != FREE_HANDLE) {
+                    offset += block->size;
+                    continue;
+                }
+
+                // Merge the run of free blocks starting here.
+                size_t end = offset + block->size;
+                while (end < _top && getBlock(end)->handle == FREE_HANDLE) {
+                    end += getBlock(end)->size;
+                }
+                block->size = end - offset;
+
+                if (end == _top) {
+                    // It's the top of the heap; give it back.
+                    _holeBytes -= block->size;
+                    _top = offset;
+                    break;
+                }
+                if (block->size >= size)
+                    return offset;
+                offset = end;
+            }
+            return _capacity; // None found.
+        }
+
+        // Allocation
+        RelocatableHeap::Handle RelocatableHeap::allocate(size_t size) {
+            if (_freeHandle == FREE_HANDLE || size > _capacity) {
+                recordAllocationFailure(_tag, size);
+                return Handle {0, 0};
+            }
+            size_t blockSize = alignUp(sizeof(BlockHeader), ALIGNMENT) +
+                    alignUp(size ? size : 1, ALIGNMENT);
+
+            size_t offset = _capacity;
+            if (blockSize <= _capacity - _top) {
+                offset = _top;
+                _top += blockSize;
+            } else {
+                offset = findHole(blockSize);
+                if (offset == _capacity && blockSize <= _capacity - _top) {
+                    offset = _top; // findHole() lowered the top.
+                    _top += blockSize;
+                } else if (offset != _capacity) {
+                    // Split the hole if the remainder can hold a header.
+                    BlockHeader* hole = getBlock(offset);
+                    size_t remainder = hole->size - blockSize;
+                    if (remainder >= ALIGNMENT) {
+                        BlockHeader* rest = getBlock(offset + blockSize);
+                        rest->size = remainder;
+                        rest->handle = FREE_HANDLE;
+                    } else {
+                        blockSize = hole->size;
+                    }
+                    _holeBytes -= blockSize;
+                }
+            }
+            if (offset == _capacity) {
+                recordAllocationFailure(_tag, size);
+                return Handle {0, 0};
+            }
+
+            // Claim a handle.
+            uint32_t index = _freeHandle;
+            HandleEntry& entry = _handles[index];
+            _freeHandle = entry.nextFree;
+            entry.nextFree = USED_HANDLE;
+            entry.offset = offset;
+
+            BlockHeader* block = getBlock(offset);
+            block->size = blockSize;
+            block->handle = index;
+            _usedBytes += blockSize;
+            _handleCount++;
+            recordAllocation(_tag, blockSize);
+            return Handle {index, entry.generation};
+        }
+        void RelocatableHeap::deallocate(Handle handle) {
+            HandleEntry* entry = getEntry(handle);
+            if (entry == nullptr)
+                return;
+
+            BlockHeader* block = getBlock(entry->offset);
+            block->handle = FREE_HANDLE;
+            _usedBytes -= block->size;
+            _handleCount--;
+            recordDeallocation(_tag, block->size);
+
+            if (entry->offset + block->size == _top)
+                _top = entry->offset;
+            else
+                _holeBytes += block->size;
+            if (entry->offset < _compactFrom)
+                _compactFrom = entry->offset;
+
+            // Retire the handle.  (Skip generation zero; it's never valid.)
+            if (++entry->generation == 0)
+                entry->generation = 1;
+            entry->nextFree = _freeHandle;
+            _freeHandle = handle.index;
+        }
+
+        // Handles
+        void* RelocatableHeap::resolve(Handle handle) const {
+            HandleEntry* entry = getEntry(handle);
+            if (entry == nullptr)
+                return nullptr;
+            return _begin + entry->offset +
+                    alignUp(sizeof(BlockHeader), ALIGNMENT);
+        }
+        bool RelocatableHeap::isValid(Handle handle) const {
+            return getEntry(handle) != nullptr;
+        }
+        size_t RelocatableHeap::getSize(Handle handle) const {
+            HandleEntry* entry = getEntry(handle);
+            if (entry == nullptr)
+                return 0;
+            return getBlock(entry->offset)->size -
+                    alignUp(sizeof(BlockHeader), ALIGNMENT);
+        }
+
+        // Compaction
+        size_t RelocatableHeap::defragment(unsigned int budgetMicroseconds) {
+            timing::Clock::TimePoint start = timing::Clock::getTime();
+            size_t moved = 0;
+
+            size_t offset = _compactFrom;
+            while (offset < _top) {
+                BlockHeader* block = getBlock(offset);
+                if (block->handle != FREE_HANDLE) {
+                    offset += block->size;
+                    continue;
+                }
+
+                // Merge the hole starting here.
+                size_t end = offset + block->size;
+                while (end < _top && getBlock(end)->handle == FREE_HANDLE) {
+                    end += getBlock(end)->size;
+                }
+                if (end == _top) {
+                    _holeBytes -= end - offset;
+                    _top = offset;
+                    break;
+                }
+
+                // Slide the next block down over the hole.  The hole ends up
+                // just past it (where it'll merge with the next one).
+                BlockHeader* next = getBlock(end);
+                size_t size = next->size;
+                uint32_t index = next->handle;
+                memmove(_begin + offset, _begin + end, size);
+                _handles[index].offset = offset;
+                moved += size;
+
+                BlockHeader* hole = getBlock(offset + size);
+                hole->size = end - offset;
+                hole->handle = FREE_HANDLE;
+                offset += size;
+
+                std::chrono::microseconds elapsed =
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                        timing::Clock::getTime() - start);
+                if (elapsed.count() >= static_cast<long long>(
+                        budgetMicroseconds))
+                    break;
+            }
+
+            _compactFrom = offset;
+            return moved;
+        }
+        bool RelocatableHeap::isCompact() const {
+            return _holeBytes == 0;
+        }
+
+        // Queries
+        RelocatableHeap::Statistics RelocatableHeap::getStatistics() const {
+            Statistics statistics {_usedBytes, _capacity - _usedBytes,
+                    _holeBytes, _handleCount, 0.0};
+            if (statistics.freeBytes != 0) {
+                statistics.fragmentation =
+                        static_cast<double>(statistics.holeBytes) /
+                        static_cast<double>(statistics.freeBytes);
+            }
+            return statistics;
+        }
+
+        // Tracking
+        void RelocatableHeap::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        MemoryTag RelocatableHeap::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
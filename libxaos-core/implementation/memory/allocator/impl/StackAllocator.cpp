@@ -0,0 +1,68 @@
+/**
+ *  @file StackAllocator.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/StackAllocator.h
+ *
+ *  This file provides implementations for the StackAllocator class.
+ */
+
+#include <utility>
+
+#include "memory/allocator/impl/StackAllocator.h"
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        constexpr const size_t StackAllocator::DEFAULT_ALIGNMENT;
+
+        // Scopes
+        StackAllocator::Scope::Scope(StackAllocator& allocator) :
+                _allocator(allocator), _bottom(allocator.getMarker()),
+                _top(allocator.getTopMarker()) {}
+        StackAllocator::Scope::~Scope() {
+            _allocator.rewind(_bottom);
+            _allocator.rewindTop(_top);
+        }
+
+        // Constructors
+        StackAllocator::StackAllocator(IStore* store) : _store(store),
+                _begin(nullptr), _capacity(0), _bottom(0), _top(0),
+                _tag(MEMORY_TAG_UNTAGGED) {
+            if (!_store || !_store->commit(_store->SIZE))
+                return;
+
+            _begin = _store->getRawStorage();
+            _capacity = _store->SIZE;
+            _top = _capacity;
+        }
+        StackAllocator::~StackAllocator() {
+            recordDeallocation(_tag, _bottom + _capacity - _top, 0);
+            if (_store)
+                delete _store;
+        }
+
+        // Move Semantics (no copying allocators!)
+        StackAllocator::StackAllocator(StackAllocator&& other) :
+                _store(other._store), _begin(other._begin),
+                _capacity(other._capacity), _bottom(other._bottom),
+                _top(other._top), _tag(other._tag) {
+            other._store = nullptr;
+            other._begin = nullptr;
+            other._capacity = 0;
+            other._bottom = 0;
+            other._top = 0;
+        }
+        StackAllocator& StackAllocator::operator=(StackAllocator&& other) {
+            if (this != &other) {
+                std::swap(_store, other._store);
+                std::swap(_begin, other._begin);
+                std::swap(_capacity, other._capacity);
+                std::swap(_bottom, other._bottom);
+                std::swap(_top, other._top);
+                std::swap(_tag, other._tag);
+            }
+            return *this;
+        }
+    }
+}
@@ -0,0 +1,528 @@
+/**
+ *  @file TLSFAllocator.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/TLSFAllocator.h
+ *
+ *  This file provides implementations for the TLSFAllocator class.  The
+ *  layout and algorithms closely follow the reference TLSF implementation:
+ *
+ *  - Every block starts with a pointer to the previous physical block
+ *    followed by its size.  The previous physical pointer is only valid when
+ *    the previous block is free; otherwise that word belongs to the previous
+ *    block's payload.  (Hence a single word of overhead per allocation.)
+ *  - The low two bits of the size record whether the block and its previous
+ *    physical neighbour are free.
+ *  - Free blocks additionally store their free list links in their payload.
+ *  - The region ends with a zero sized "sentinel" block that is always used.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "memory/allocator/impl/TLSFAllocator.h"
+#include "memory/store/IStore.h"
+#include "memory/utility/alignment.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // The block header.  See the file comment for the layout.
+        struct TLSFAllocator::Block {
+            Block* previousPhysical;
+            size_t size;
+            Block* nextFree;
+            Block* previousFree;
+        };
+
+        // Static Constants
+        constexpr const size_t TLSFAllocator::DEFAULT_ALIGNMENT;
+        constexpr const size_t TLSFAllocator::ALIGN_SIZE_LOG2;
+        constexpr const size_t TLSFAllocator::SL_INDEX_COUNT_LOG2;
+        constexpr const size_t TLSFAllocator::SL_INDEX_COUNT;
+        constexpr const size_t TLSFAllocator::FL_INDEX_MAX;
+        constexpr const size_t TLSFAllocator::FL_INDEX_SHIFT;
+        constexpr const size_t TLSFAllocator::FL_INDEX_COUNT;
+
+        // Helpers!  Only visible here.
+        namespace {
+            using Block = TLSFAllocator::Block;
+
+            constexpr size_t ALIGN_SIZE = TLSFAllocator::DEFAULT_ALIGNMENT;
+            constexpr size_t FREE_BIT = 1;
+            constexpr size_t PREVIOUS_FREE_BIT = 2;
+            constexpr size_t FLAG_BITS = FREE_BIT | PREVIOUS_FREE_BIT;
+
+            // Only the size field is overhead on a used block.
+            constexpr size_t BLOCK_OVERHEAD = sizeof(size_t);
+            // The payload begins just after the size field.
+            constexpr size_t BLOCK_START_OFFSET = 2 * sizeof(void*);
+            // A free block must be able to hold its list links.
+            constexpr size_t BLOCK_SIZE_MIN = sizeof(Block) - sizeof(Block*);
+
+            // Bit Scanning
+            inline size_t findFirstSet(uint32_t word) {
+                assert(word != 0);
+                #ifdef _MSC_VER
+                    unsigned long index;
+                    _BitScanForward(&index, word);
+                    return index;
+                #else
+                    return static_cast<size_t>(__builtin_ctz(word));
+                #endif
+            }
+            inline size_t findLastSet(size_t word) {
+                assert(word != 0);
+                #if defined(_MSC_VER) && defined(_WIN64)
+                    unsigned long index;
+                    _BitScanReverse64(&index, word);
+                    return index;
+                #elif defined(_MSC_VER)
+                    unsigned long index;
+                    _BitScanReverse(&index, word);
+                    return index;
+                #else
+                    return sizeof(unsigned long long) * 8 - 1 -
+                            static_cast<size_t>(__builtin_clzll(word));
+                #endif
+            }
+
+            // Block Accessors
+            inline size_t getSize(const Block* block) {
+                return block->size & ~FLAG_BITS;
+            }
+            inline void setSize(Block* block, size_t size) {
+                block->size = size | (block->size & FLAG_BITS);
+            }
+            inline bool isLast(const Block* block) {
+                return getSize(block) == 0;
+            }
+            inline bool isFree(const Block* block) {
+                return (block->size & FREE_BIT) != 0;
+            }
+            inline void setFree(Block* block) {
+                block->size |= FREE_BIT;
+            }
+            inline void setUsed(Block* block) {
+                block->size &= ~FREE_BIT;
+            }
+            inline bool isPreviousFree(const Block* block) {
+                return (block->size & PREVIOUS_FREE_BIT) != 0;
+            }
+            inline void setPreviousFree(Block* block) {
+                block->size |= PREVIOUS_FREE_BIT;
+            }
+            inline void setPreviousUsed(Block* block) {
+                block->size &= ~PREVIOUS_FREE_BIT;
+            }
+
+            // Block Navigation
+            inline Block* fromPointer(const void* pointer) {
+                return reinterpret_cast<Block*>(
+                        const_cast<uint8_t*>(static_cast<const uint8_t*>(
+                        pointer)) - BLOCK_START_OFFSET);
+            }
+            inline uint8_t* toPointer(Block* block) {
+                return reinterpret_cast<uint8_t*>(block) + BLOCK_START_OFFSET;
+            }
+            inline Block* offsetToBlock(uint8_t* pointer, ptrdiff_t offset) {
+                return reinterpret_cast<Block*>(pointer + offset);
+            }
+            inline Block* getNext(Block* block) {
+                assert(!isLast(block));
+                return offsetToBlock(toPointer(block),
+                        static_cast<ptrdiff_t>(getSize(block)) -
+                        static_cast<ptrdiff_t>(BLOCK_OVERHEAD));
+            }
+            inline Block* linkNext(Block* block) {
+                Block* next = getNext(block);
+                next->previousPhysical = block;
+                return next;
+            }
+            inline void markAsFree(Block* block) {
+                Block* next = linkNext(block);
+                setPreviousFree(next);
+                setFree(block);
+            }
+            inline void markAsUsed(Block* block) {
+                Block* next = getNext(block);
+                setPreviousUsed(next);
+                setUsed(block);
+            }
+
+            // Size Helpers
+            inline size_t adjustRequestSize(size_t size) {
+                if (size == 0 || size >= (size_t(1) <<
+                        TLSFAllocator::FL_INDEX_MAX) - ALIGN_SIZE)
+                    return 0;
+
+                size_t aligned = alignUp(size, ALIGN_SIZE);
+                return aligned < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : aligned;
+            }
+            inline void mappingInsert(size_t size, size_t& fl, size_t& sl) {
+                constexpr size_t SMALL_BLOCK_SIZE =
+                        size_t(1) << TLSFAllocator::FL_INDEX_SHIFT;
+                if (size < SMALL_BLOCK_SIZE) {
+                    fl = 0;
+                    sl = size / (SMALL_BLOCK_SIZE /
+                            TLSFAllocator::SL_INDEX_COUNT);
+                } else {
+                    fl = findLastSet(size);
+                    sl = (size >> (fl - TLSFAllocator::SL_INDEX_COUNT_LOG2)) ^
+                            (size_t(1) << TLSFAllocator::SL_INDEX_COUNT_LOG2);
+                    fl -= TLSFAllocator::FL_INDEX_SHIFT - 1;
+                }
+            }
+            // Rounds up to the next list so any block found is big enough.
+            inline void mappingSearch(size_t size, size_t& fl, size_t& sl) {
+                if (size >= (size_t(1) << TLSFAllocator::FL_INDEX_SHIFT)) {
+                    size_t round = (size_t(1) << (findLastSet(size) -
+                            TLSFAllocator::SL_INDEX_COUNT_LOG2)) - 1;
+                    size += round;
+                }
+                mappingInsert(size, fl, sl);
+            }
+        }
+
+        // Constructors
+        TLSFAllocator::TLSFAllocator(IStore* store) : _store(store),
+                _begin(nullptr), _end(nullptr), _usedBytes(0), _freeBytes(0),
+                _allocationCount(0), _flBitmap(0), _slBitmap(), _blocks(),
+                _tag(MEMORY_TAG_UNTAGGED) {
+            if (!_store || !_store->commit(_store->SIZE))
+                return;
+
+            // We need room for the first block's size and the sentinel.
+            uint8_t* raw = _store->getRawStorage();
+            uint8_t* memory = alignUp(raw, ALIGN_SIZE);
+            size_t padding = static_cast<size_t>(memory - raw);
+            if (padding + 2 * BLOCK_OVERHEAD + BLOCK_SIZE_MIN > _store->SIZE)
+                return;
+
+            size_t poolBytes = alignDown(_store->SIZE - padding -
+                    2 * BLOCK_OVERHEAD, ALIGN_SIZE);
+            size_t maxBytes = (size_t(1) << FL_INDEX_MAX) - ALIGN_SIZE;
+            if (poolBytes > maxBytes)
+                poolBytes = maxBytes;
+
+            // The first block's previousPhysical lies before the region but
+            // it's never touched since its previous block is never free.
+            Block* block = offsetToBlock(memory,
+                    -static_cast<ptrdiff_t>(BLOCK_OVERHEAD));
+            block->size = poolBytes;
+            setFree(block);
+            setPreviousUsed(block);
+            insertBlock(block);
+
+            // And the sentinel.
+            Block* sentinel = linkNext(block);
+            sentinel->size = 0;
+            setUsed(sentinel);
+            setPreviousFree(sentinel);
+
+            _begin = memory;
+            _end = memory + poolBytes + 2 * BLOCK_OVERHEAD;
+        }
+        TLSFAllocator::~TLSFAllocator() {
+            recordDeallocation(_tag, _usedBytes, _allocationCount);
+            if (_store)
+                delete _store;
+        }
+
+        // Free List Management
+        void TLSFAllocator::insertFreeBlock(Block* block, size_t fl,
+                size_t sl) {
+            Block* current = _blocks[fl][sl];
+            block->nextFree = current;
+            block->previousFree = nullptr;
+            if (current)
+                current->previousFree = block;
+            _blocks[fl][sl] = block;
+
+            _flBitmap |= uint32_t(1) << fl;
+            _slBitmap[fl] |= uint32_t(1) << sl;
+            _freeBytes += getSize(block);
+        }
+        void TLSFAllocator::removeFreeBlock(Block* block, size_t fl,
+                size_t sl) {
+            Block* previous = block->previousFree;
+            Block* next = block->nextFree;
+            if (next)
+                next->previousFree = previous;
+            if (previous)
+                previous->nextFree = next;
+
+            if (_blocks[fl][sl] == block) {
+                _blocks[fl][sl] = next;
+                if (next == nullptr) {
+                    _slBitmap[fl] &= ~(uint32_t(1) << sl);
+                    if (_slBitmap[fl] == 0)
+                        _flBitmap &= ~(uint32_t(1) << fl);
+                }
+            }
+            _freeBytes -= getSize(block);
+        }
+        void TLSFAllocator::insertBlock(Block* block) {
+            size_t fl, sl;
+            mappingInsert(getSize(block), fl, sl);
+            insertFreeBlock(block, fl, sl);
+        }
+        void TLSFAllocator::removeBlock(Block* block) {
+            size_t fl, sl;
+            mappingInsert(getSize(block), fl, sl);
+            removeFreeBlock(block, fl, sl);
+        }
+        TLSFAllocator::Block* TLSFAllocator::searchSuitableBlock(size_t& fl,
+                size_t& sl) const {
+            // First, look in the requested first level for a big enough list.
+            uint32_t slMap = _slBitmap[fl] & (~uint32_t(0) << sl);
+            if (slMap == 0) {
+                // Nothing.. try the next non-empty first level.
+                uint32_t flMap = _flBitmap & (~uint32_t(0) << (fl + 1));
+                if (flMap == 0)
+                    return nullptr; // Out of memory!
+
+                fl = findFirstSet(flMap);
+                slMap = _slBitmap[fl];
+            }
+            sl = findFirstSet(slMap);
+            return _blocks[fl][sl];
+        }
+
+        // Splitting and Merging
+        TLSFAllocator::Block* TLSFAllocator::mergePrevious(Block* block) {
+            if (isPreviousFree(block)) {
+                Block* previous = block->previousPhysical;
+                assert(isFree(previous));
+                removeBlock(previous);
+                previous->size += getSize(block) + BLOCK_OVERHEAD;
+                linkNext(previous);
+                block = previous;
+            }
+            return block;
+        }
+        TLSFAllocator::Block* TLSFAllocator::mergeNext(Block* block) {
+            Block* next = getNext(block);
+            if (isFree(next)) {
+                assert(!isLast(block));
+                removeBlock(next);
+                block->size += getSize(next) + BLOCK_OVERHEAD;
+                linkNext(block);
+            }
+            return block;
+        }
+
+        // Splits the block, returning the (free) remainder.  The remainder's
+        // previous free bit is left for the caller to set.
+        static Block* split(Block* block, size_t size) {
+            Block* remaining = offsetToBlock(toPointer(block),
+                    static_cast<ptrdiff_t>(size - BLOCK_OVERHEAD));
+            remaining->size = getSize(block) - (size + BLOCK_OVERHEAD);
+            setSize(block, size);
+            markAsFree(remaining);
+            return remaining;
+        }
+        static bool canSplit(const Block* block, size_t size) {
+            return getSize(block) >= sizeof(Block) + size;
+        }
+
+        void TLSFAllocator::trimFree(Block* block, size_t size) {
+            assert(isFree(block));
+            if (canSplit(block, size)) {
+                Block* remaining = split(block, size);
+                linkNext(block);
+                setPreviousFree(remaining);
+                insertBlock(remaining);
+            }
+        }
+        void TLSFAllocator::trimUsed(Block* block, size_t size) {
+            assert(!isFree(block));
+            if (canSplit(block, size)) {
+                Block* remaining = split(block, size);
+                setPreviousUsed(remaining);
+                remaining = mergeNext(remaining);
+                insertBlock(remaining);
+            }
+        }
+        TLSFAllocator::Block* TLSFAllocator::trimFreeLeading(Block* block,
+                size_t size) {
+            Block* remaining = block;
+            if (canSplit(block, size)) {
+                remaining = split(block, size - BLOCK_OVERHEAD);
+                setPreviousFree(remaining);
+                linkNext(block);
+                insertBlock(block);
+            }
+            return remaining;
+        }
+        TLSFAllocator::Block* TLSFAllocator::locateFree(size_t size) {
+            if (size == 0)
+                return nullptr;
+
+            size_t fl, sl;
+            mappingSearch(size, fl, sl);
+            if (fl >= FL_INDEX_COUNT)
+                return nullptr;
+
+            Block* block = searchSuitableBlock(fl, sl);
+            if (block) {
+                assert(getSize(block) >= size);
+                removeFreeBlock(block, fl, sl);
+            }
+            return block;
+        }
+        void* TLSFAllocator::prepareUsed(Block* block, size_t size) {
+            if (block == nullptr) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            trimFree(block, size);
+            markAsUsed(block);
+            _usedBytes += getSize(block);
+            _allocationCount++;
+            recordAllocation(_tag, getSize(block));
+            return toPointer(block);
+        }
+
+        // Allocation
+        void* TLSFAllocator::allocate(size_t size, size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+
+            size_t adjust = adjustRequestSize(size);
+            if (adjust == 0 || _begin == nullptr)
+                return nullptr;
+            if (alignment <= ALIGN_SIZE)
+                return prepareUsed(locateFree(adjust), adjust);
+
+            // We need a big enough block that we can trim a free block off
+            // of the front of it to reach the alignment.
+            const size_t gapMinimum = sizeof(Block);
+            size_t withGap = adjustRequestSize(adjust + alignment +
+                    gapMinimum);
+            if (withGap == 0)
+                return nullptr;
+
+            Block* block = locateFree(withGap);
+            if (block) {
+                uint8_t* pointer = toPointer(block);
+                uint8_t* aligned = alignUp(pointer, alignment);
+                size_t gap = static_cast<size_t>(aligned - pointer);
+
+                // The gap must be able to hold a block.. nudge it forwards.
+                if (gap && gap < gapMinimum) {
+                    size_t remain = gapMinimum - gap;
+                    size_t offset = remain > alignment ? remain : alignment;
+                    aligned = alignUp(aligned + offset, alignment);
+                    gap = static_cast<size_t>(aligned - pointer);
+                }
+                if (gap)
+                    block = trimFreeLeading(block, gap);
+            }
+            return prepareUsed(block, adjust);
+        }
+        void TLSFAllocator::deallocate(void* pointer) {
+            if (pointer == nullptr)
+                return;
+
+            assert(owns(pointer)); // Not one of ours!
+            Block* block = fromPointer(pointer);
+            assert(!isFree(block)); // Double free?
+
+            _usedBytes -= getSize(block);
+            _allocationCount--;
+            recordDeallocation(_tag, getSize(block));
+
+            markAsFree(block);
+            block = mergePrevious(block);
+            block = mergeNext(block);
+            insertBlock(block);
+        }
+        void* TLSFAllocator::reallocate(void* pointer, size_t size) {
+            if (pointer && size == 0) {
+                deallocate(pointer);
+                return nullptr;
+            }
+            if (pointer == nullptr)
+                return allocate(size);
+
+            assert(owns(pointer)); // Not one of ours!
+            Block* block = fromPointer(pointer);
+            Block* next = getNext(block);
+            size_t current = getSize(block);
+            size_t combined = current + getSize(next) + BLOCK_OVERHEAD;
+            size_t adjust = adjustRequestSize(size);
+            if (adjust == 0)
+                return nullptr;
+
+            // If we can't grow in place, move.
+            if (adjust > current && (!isFree(next) || adjust > combined)) {
+                void* moved = allocate(size);
+                if (moved) {
+                    memcpy(moved, pointer, current < size ? current : size);
+                    deallocate(pointer);
+                }
+                return moved;
+            }
+
+            // Otherwise grow / shrink in place.
+            _usedBytes -= current;
+            if (adjust > current) {
+                mergeNext(block);
+                markAsUsed(block);
+            }
+            trimUsed(block, adjust);
+            _usedBytes += getSize(block);
+            if (getSize(block) > current)
+                recordAllocation(_tag, getSize(block) - current, 0);
+            else
+                recordDeallocation(_tag, current - getSize(block), 0);
+            return pointer;
+        }
+
+        // Queries
+        bool TLSFAllocator::owns(const void* pointer) const {
+            const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+            return bytes >= _begin && bytes < _end;
+        }
+        size_t TLSFAllocator::getAllocationSize(const void* pointer) const {
+            if (pointer == nullptr)
+                return 0;
+            return getSize(fromPointer(pointer));
+        }
+        TLSFAllocator::Statistics TLSFAllocator::getStatistics() const {
+            Statistics statistics {_usedBytes, _freeBytes, 0,
+                    _allocationCount, 0.0};
+
+            // The largest block lives in the highest non-empty list.
+            if (_flBitmap != 0) {
+                size_t fl = findLastSet(_flBitmap);
+                size_t sl = findLastSet(_slBitmap[fl]);
+                for (Block* block = _blocks[fl][sl]; block;
+                        block = block->nextFree) {
+                    if (getSize(block) > statistics.largestFreeBlock)
+                        statistics.largestFreeBlock = getSize(block);
+                }
+            }
+
+            if (_freeBytes != 0) {
+                statistics.fragmentation = 1.0 -
+                        static_cast<double>(statistics.largestFreeBlock) /
+                        static_cast<double>(_freeBytes);
+            }
+            return statistics;
+        }
+
+        // Tracking
+        void TLSFAllocator::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        MemoryTag TLSFAllocator::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
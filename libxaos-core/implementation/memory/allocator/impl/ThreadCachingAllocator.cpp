@@ -0,0 +1,471 @@
+/**
+ *  @file ThreadCachingAllocator.cpp
+ *  @brief Implements: libxaos-core:memory/allocator/impl/ThreadCachingAllocator.h
+ *
+ *  This file provides implementations for the ThreadCachingAllocator class.
+ *
+ *  The store is laid out as a sequence of spans.  The first few spans hold a
+ *  table with the size class of every span (so deallocate() can find an
+ *  object's class from its address alone).  Spans used for the allocator's
+ *  own bookkeeping (ThreadCaches) are marked with METADATA_CLASS.
+ */
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "memory/allocator/impl/ThreadCachingAllocator.h"
+#include "memory/store/IStore.h"
+#include "memory/utility/alignment.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Every thread's cache for a single allocator.
+        struct ThreadCachingAllocator::ThreadCache {
+            FreeObject* heads[SIZE_CLASS_COUNT];
+            size_t counts[SIZE_CLASS_COUNT];
+            ThreadCache* nextSpare;
+        };
+
+        // Static Constants
+        constexpr const size_t ThreadCachingAllocator::SPAN_SIZE;
+        constexpr const size_t ThreadCachingAllocator::MAX_SMALL_SIZE;
+        constexpr const size_t ThreadCachingAllocator::SIZE_CLASS_COUNT;
+        constexpr const size_t ThreadCachingAllocator::DEFAULT_ALIGNMENT;
+        constexpr const size_t ThreadCachingAllocator::MAX_INSTANCES;
+
+        // Helpers!  Only visible here.
+        namespace {
+            //! Marks spans that don't hold objects.
+            constexpr uint8_t METADATA_CLASS = 0xFF;
+
+            //! The allocators that own each thread cache slot.
+            std::atomic<ThreadCachingAllocator*>
+                    instances[ThreadCachingAllocator::MAX_INSTANCES];
+            //! Bumped every time a slot changes hands.
+            std::atomic<uint32_t>
+                    generations[ThreadCachingAllocator::MAX_INSTANCES];
+
+            //! Precedes every large allocation.
+            struct LargeHeader {
+                void* raw;
+                size_t size;
+            };
+            constexpr size_t LARGE_HEADER_SIZE =
+                    alignUp(sizeof(LargeHeader),
+                    ThreadCachingAllocator::DEFAULT_ALIGNMENT);
+
+            inline size_t findLastSet(size_t word) {
+                assert(word != 0);
+                #if defined(_MSC_VER) && defined(_WIN64)
+                    unsigned long index;
+                    _BitScanReverse64(&index, word);
+                    return index;
+                #elif defined(_MSC_VER)
+                    unsigned long index;
+                    _BitScanReverse(&index, word);
+                    return index;
+                #else
+                    return sizeof(unsigned long long) * 8 - 1 -
+                            static_cast<size_t>(__builtin_clzll(word));
+                #endif
+            }
+
+            //! The number of objects moved between a cache and a depot.
+            inline size_t getBatchSize(size_t sizeClass) {
+                size_t count = 4096 / ThreadCachingAllocator::getClassSize(
+                        sizeClass);
+                return count < 2 ? 2 : (count > 32 ? 32 : count);
+            }
+        }
+
+        // The thread local slots.  Returns caches to their allocators when
+        // the thread exits (if those allocators still exist).
+        struct ThreadCachingAllocator::ThreadCacheSlots {
+            ThreadCache* caches[MAX_INSTANCES];
+            uint32_t generations[MAX_INSTANCES];
+
+            ~ThreadCacheSlots() {
+                for (size_t i = 0; i < MAX_INSTANCES; i++) {
+                    if (caches[i] == nullptr ||
+                            memory::generations[i].load() != generations[i])
+                        continue;
+
+                    ThreadCachingAllocator* owner = instances[i].load();
+                    if (owner)
+                        owner->releaseThreadCache(caches[i]);
+                    caches[i] = nullptr;
+                }
+            }
+        };
+        thread_local ThreadCachingAllocator::ThreadCacheSlots
+                ThreadCachingAllocator::_threadSlots {};
+
+        // Size Classes
+        // Up to 128 bytes classes are 16 bytes apart, after that each power
+        // of two is split into four classes.
+        size_t ThreadCachingAllocator::getSizeClass(size_t size) {
+            assert(size <= MAX_SMALL_SIZE);
+            if (size <= 128)
+                return size == 0 ? 0 : (size - 1) / 16;
+
+            size_t power = findLastSet(size - 1);
+            return 8 + (power - 7) * 4 +
+                    ((size - 1 - (size_t(1) << power)) >> (power - 2));
+        }
+        size_t ThreadCachingAllocator::getClassSize(size_t sizeClass) {
+            assert(sizeClass < SIZE_CLASS_COUNT);
+            if (sizeClass < 8)
+                return (sizeClass + 1) * 16;
+
+            size_t power = 7 + (sizeClass - 8) / 4;
+            size_t step = (sizeClass - 8) % 4 + 1;
+            return (size_t(1) << power) + step * (size_t(1) << (power - 2));
+        }
+
+        // Constructors
+        ThreadCachingAllocator::ThreadCachingAllocator(IStore* store) :
+                _store(store), _begin(nullptr), _spanClasses(nullptr),
+                _spanCapacity(0), _spanCount(0), _spanMutex(),
+                _metadata(nullptr), _metadataUsed(0), _spareCaches(nullptr),
+                _depots(), _slot(MAX_INSTANCES), _generation(0),
+                _tag(MEMORY_TAG_UNTAGGED) {
+            // Claim a thread cache slot (if there's one left).
+            for (size_t i = 0; i < MAX_INSTANCES; i++) {
+                ThreadCachingAllocator* expected = nullptr;
+                if (instances[i].compare_exchange_strong(expected, this)) {
+                    _slot = i;
+                    _generation = ++generations[i];
+                    break;
+                }
+            }
+
+            // Lay out our span table.
+            if (!_store || _store->SIZE < 2 * SPAN_SIZE)
+                return;
+
+            // Spans start DEFAULT_ALIGNMENT aligned (whatever the store's
+            // alignment) so the objects carved from them are too.
+            uint8_t* raw = _store->getRawStorage();
+            size_t offset = getAlignmentOffset(raw, DEFAULT_ALIGNMENT);
+            size_t capacity = (_store->SIZE - offset) / SPAN_SIZE;
+            size_t tableSpans = (capacity + SPAN_SIZE - 1) / SPAN_SIZE;
+            if (capacity < 2 || !_store->commit(offset +
+                    tableSpans * SPAN_SIZE))
+                return;
+
+            _begin = raw + offset;
+            _spanClasses = _begin;
+            memset(_spanClasses, 0, capacity);
+            memset(_spanClasses, METADATA_CLASS, tableSpans);
+            _spanCapacity = capacity;
+            _spanCount = tableSpans;
+        }
+        ThreadCachingAllocator::~ThreadCachingAllocator() {
+            if (_slot < MAX_INSTANCES) {
+                generations[_slot]++;
+                instances[_slot] = nullptr;
+            }
+            if (_store)
+                delete _store;
+        }
+
+        // Thread Caches
+        ThreadCachingAllocator::ThreadCache*
+                ThreadCachingAllocator::getThreadCache() {
+            if (_slot >= MAX_INSTANCES)
+                return nullptr;
+
+            ThreadCacheSlots& slots = _threadSlots;
+            if (slots.caches[_slot] && slots.generations[_slot] == _generation)
+                return slots.caches[_slot];
+
+            // Make a new one.
+            ThreadCache* cache = nullptr;
+            {
+                std::lock_guard<std::mutex> lock {_spanMutex};
+                if (_spareCaches) {
+                    cache = _spareCaches;
+                    _spareCaches = cache->nextSpare;
+                } else {
+                    cache = reinterpret_cast<ThreadCache*>(
+                            carveMetadata(sizeof(ThreadCache)));
+                }
+            }
+            if (cache == nullptr)
+                return nullptr;
+
+            memset(cache, 0, sizeof(ThreadCache));
+            slots.caches[_slot] = cache;
+            slots.generations[_slot] = _generation;
+            return cache;
+        }
+        void ThreadCachingAllocator::releaseThreadCache(ThreadCache* cache) {
+            for (size_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+                drain(cache, i, cache->counts[i]);
+            }
+
+            std::lock_guard<std::mutex> lock {_spanMutex};
+            cache->nextSpare = _spareCaches;
+            _spareCaches = cache;
+        }
+        void ThreadCachingAllocator::flushThreadCache() {
+            if (_slot >= MAX_INSTANCES)
+                return;
+
+            ThreadCacheSlots& slots = _threadSlots;
+            if (slots.caches[_slot] == nullptr ||
+                    slots.generations[_slot] != _generation)
+                return;
+
+            releaseThreadCache(slots.caches[_slot]);
+            slots.caches[_slot] = nullptr;
+        }
+
+        // Moving objects between caches and depots.
+        bool ThreadCachingAllocator::refill(ThreadCache* cache,
+                size_t sizeClass) {
+            Depot& depot = _depots[sizeClass];
+            std::lock_guard<std::mutex> lock {depot.mutex};
+            if (depot.head == nullptr && !carveSpan(sizeClass))
+                return false;
+
+            // Detach up to a batch from the front of the depot.
+            size_t batch = getBatchSize(sizeClass);
+            FreeObject* first = depot.head;
+            FreeObject* last = first;
+            size_t count = 1;
+            while (count < batch && last->next) {
+                last = last->next;
+                count++;
+            }
+
+            depot.head = last->next;
+            depot.count -= count;
+            last->next = cache->heads[sizeClass];
+            cache->heads[sizeClass] = first;
+            cache->counts[sizeClass] += count;
+            return true;
+        }
+        void ThreadCachingAllocator::drain(ThreadCache* cache,
+                size_t sizeClass, size_t count) {
+            if (count == 0)
+                return;
+
+            // Detach the batch from the front of the cache.
+            FreeObject* first = cache->heads[sizeClass];
+            FreeObject* last = first;
+            for (size_t i = 1; i < count; i++) {
+                last = last->next;
+            }
+            cache->heads[sizeClass] = last->next;
+            cache->counts[sizeClass] -= count;
+
+            Depot& depot = _depots[sizeClass];
+            std::lock_guard<std::mutex> lock {depot.mutex};
+            last->next = depot.head;
+            depot.head = first;
+            depot.count += count;
+        }
+
+        // Carving Spans
+        bool ThreadCachingAllocator::carveSpan(size_t sizeClass) {
+            uint8_t* span = nullptr;
+            {
+                std::lock_guard<std::mutex> lock {_spanMutex};
+                size_t index = _spanCount;
+                if (index >= _spanCapacity ||
+                        !commitSpans(index + 1))
+                    return false;
+
+                span = _begin + index * SPAN_SIZE;
+                _spanClasses[index] = static_cast<uint8_t>(sizeClass);
+                _spanCount = index + 1;
+            }
+
+            // Thread the span's objects onto the depot (in address order).
+            Depot& depot = _depots[sizeClass];
+            size_t size = getClassSize(sizeClass);
+            size_t count = SPAN_SIZE / size;
+            for (size_t i = count; i > 0; i--) {
+                FreeObject* object = reinterpret_cast<FreeObject*>(
+                        span + (i - 1) * size);
+                object->next = depot.head;
+                depot.head = object;
+            }
+            depot.count += count;
+            return true;
+        }
+        bool ThreadCachingAllocator::commitSpans(size_t count) {
+            return _store->commit(static_cast<size_t>(
+                    _begin - _store->getRawStorage()) + count * SPAN_SIZE);
+        }
+        uint8_t* ThreadCachingAllocator::carveMetadata(size_t size) {
+            size = alignUp(size, DEFAULT_ALIGNMENT);
+            if (_metadata == nullptr || _metadataUsed + size > SPAN_SIZE) {
+                size_t index = _spanCount;
+                if (index >= _spanCapacity ||
+                        !commitSpans(index + 1))
+                    return nullptr;
+
+                _metadata = _begin + index * SPAN_SIZE;
+                _metadataUsed = 0;
+                _spanClasses[index] = METADATA_CLASS;
+                _spanCount = index + 1;
+            }
+
+            uint8_t* pointer = _metadata + _metadataUsed;
+            _metadataUsed += size;
+            return pointer;
+        }
+
+        // Allocation
+        void* ThreadCachingAllocator::allocate(size_t size, size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+
+            // Objects in classes that are multiples of the alignment are
+            // aligned as well (up to the store's own alignment).
+            if (alignment > DEFAULT_ALIGNMENT) {
+                if (_store == nullptr || alignment > _store->ALIGNMENT)
+                    return allocateLarge(size, alignment);
+                size = alignUp(size, alignment);
+            }
+            if (size > MAX_SMALL_SIZE || _spanCapacity == 0)
+                return allocateLarge(size, alignment);
+
+            size_t sizeClass = getSizeClass(size);
+            if (getClassSize(sizeClass) % alignment != 0)
+                return allocateLarge(size, alignment);
+
+            ThreadCache* cache = getThreadCache();
+            if (cache == nullptr) {
+                void* object = allocateFromDepot(sizeClass);
+                if (object == nullptr)
+                    return allocateLarge(size, alignment);
+
+                recordAllocation(_tag, getClassSize(sizeClass));
+                return object;
+            }
+
+            if (cache->heads[sizeClass] == nullptr &&
+                    !refill(cache, sizeClass))
+                return allocateLarge(size, alignment); // Store is full!
+
+            FreeObject* object = cache->heads[sizeClass];
+            cache->heads[sizeClass] = object->next;
+            cache->counts[sizeClass]--;
+            recordAllocation(_tag, getClassSize(sizeClass));
+            return object;
+        }
+        void* ThreadCachingAllocator::allocateFromDepot(size_t sizeClass) {
+            Depot& depot = _depots[sizeClass];
+            std::lock_guard<std::mutex> lock {depot.mutex};
+            if (depot.head == nullptr && !carveSpan(sizeClass))
+                return nullptr;
+
+            FreeObject* object = depot.head;
+            depot.head = object->next;
+            depot.count--;
+            return object;
+        }
+        void* ThreadCachingAllocator::allocateLarge(size_t size,
+                size_t alignment) {
+            if (alignment < DEFAULT_ALIGNMENT)
+                alignment = DEFAULT_ALIGNMENT;
+
+            void* raw = std::malloc(size + alignment + LARGE_HEADER_SIZE);
+            if (raw == nullptr) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            uint8_t* pointer = alignUp(static_cast<uint8_t*>(raw) +
+                    LARGE_HEADER_SIZE, alignment);
+            LargeHeader* header = reinterpret_cast<LargeHeader*>(
+                    pointer - LARGE_HEADER_SIZE);
+            header->raw = raw;
+            header->size = size;
+            recordAllocation(_tag, size);
+            return pointer;
+        }
+        void ThreadCachingAllocator::deallocate(void* pointer) {
+            if (pointer == nullptr)
+                return;
+            if (MEMORY_TRACKING_ENABLED)
+                recordDeallocation(_tag, getAllocationSize(pointer));
+
+            if (!owns(pointer)) {
+                LargeHeader* header = reinterpret_cast<LargeHeader*>(
+                        static_cast<uint8_t*>(pointer) - LARGE_HEADER_SIZE);
+                std::free(header->raw);
+                return;
+            }
+
+            size_t index = static_cast<size_t>(
+                    static_cast<uint8_t*>(pointer) - _begin) / SPAN_SIZE;
+            size_t sizeClass = _spanClasses[index];
+            assert(sizeClass < SIZE_CLASS_COUNT); // Not an object!
+            FreeObject* object = static_cast<FreeObject*>(pointer);
+
+            ThreadCache* cache = getThreadCache();
+            if (cache == nullptr) {
+                Depot& depot = _depots[sizeClass];
+                std::lock_guard<std::mutex> lock {depot.mutex};
+                object->next = depot.head;
+                depot.head = object;
+                depot.count++;
+                return;
+            }
+
+            object->next = cache->heads[sizeClass];
+            cache->heads[sizeClass] = object;
+
+            // Holding too many?  (We're freeing another thread's objects.)
+            size_t batch = getBatchSize(sizeClass);
+            if (++cache->counts[sizeClass] > 2 * batch)
+                drain(cache, sizeClass, batch);
+        }
+
+        // Queries
+        bool ThreadCachingAllocator::owns(const void* pointer) const {
+            const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+            return _begin != nullptr && bytes >= _begin &&
+                    bytes < _begin + _spanCapacity * SPAN_SIZE;
+        }
+        size_t ThreadCachingAllocator::getAllocationSize(
+                const void* pointer) const {
+            if (pointer == nullptr)
+                return 0;
+
+            if (!owns(pointer)) {
+                const LargeHeader* header =
+                        reinterpret_cast<const LargeHeader*>(
+                        static_cast<const uint8_t*>(pointer) -
+                        LARGE_HEADER_SIZE);
+                return header->size;
+            }
+
+            size_t index = static_cast<size_t>(
+                    static_cast<const uint8_t*>(pointer) - _begin) / SPAN_SIZE;
+            return getClassSize(_spanClasses[index]);
+        }
+        size_t ThreadCachingAllocator::getSpanCount() const {
+            return _spanCount;
+        }
+
+        // Tracking
+        void ThreadCachingAllocator::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        MemoryTag ThreadCachingAllocator::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
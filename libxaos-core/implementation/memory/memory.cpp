@@ -0,0 +1,76 @@
+/**
+ *  @file memory.cpp
+ *  @brief Implements: libxaos-core:memory/memory.h
+ *
+ *  This file provides the global allocator and (when
+ *  LIBXAOS_FLAG_REPLACE_GLOBAL_NEW is defined) the replacement global
+ *  operator new and operator delete.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "memory/memory.h"
+#include "memory/store/impl/VirtualStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Helpers!  Only visible here.
+        namespace {
+            //! The address space reserved for the global allocator.
+            constexpr size_t GLOBAL_RESERVE = sizeof(void*) >= 8 ?
+                    size_t(16) * 1024 * 1024 * 1024 : 256 * 1024 * 1024;
+
+            // Neither object may come from the heap (operator new may be
+            // routed to them!) and neither is ever destroyed.
+            alignas(VirtualStore) uint8_t storeBuffer[sizeof(VirtualStore)];
+            alignas(ThreadCachingAllocator)
+                    uint8_t allocatorBuffer[sizeof(ThreadCachingAllocator)];
+        }
+
+        ThreadCachingAllocator& getGlobalAllocator() {
+            static ThreadCachingAllocator* allocator =
+                    new (allocatorBuffer) ThreadCachingAllocator(
+                    new (storeBuffer) VirtualStore(GLOBAL_RESERVE));
+            return *allocator;
+        }
+    }
+}
+
+#ifdef LIBXAOS_FLAG_REPLACE_GLOBAL_NEW
+
+    void* operator new(std::size_t size) {
+        void* pointer = libxaos::memory::getGlobalAllocator().allocate(
+                size == 0 ? 1 : size);
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+        return pointer;
+    }
+    void* operator new[](std::size_t size) {
+        return operator new(size);
+    }
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+        return libxaos::memory::getGlobalAllocator().allocate(
+                size == 0 ? 1 : size);
+    }
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+        return libxaos::memory::getGlobalAllocator().allocate(
+                size == 0 ? 1 : size);
+    }
+
+    void operator delete(void* pointer) noexcept {
+        libxaos::memory::getGlobalAllocator().deallocate(pointer);
+    }
+    void operator delete[](void* pointer) noexcept {
+        libxaos::memory::getGlobalAllocator().deallocate(pointer);
+    }
+    void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+        libxaos::memory::getGlobalAllocator().deallocate(pointer);
+    }
+    void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+        libxaos::memory::getGlobalAllocator().deallocate(pointer);
+    }
+
+#endif   // LIBXAOS_FLAG_REPLACE_GLOBAL_NEW
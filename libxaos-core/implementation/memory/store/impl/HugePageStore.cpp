@@ -0,0 +1,124 @@
+/**
+ *  @file HugePageStore.cpp
+ *  @brief Implements: libxaos-core:memory/store/impl/HugePageStore.h
+ *
+ *  This file provides implementations for the HugePageStore class.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/store/impl/HugePageStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/pages.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Touches every page so they're all faulted in now rather than later.
+        static void prefaultRange(uint8_t* begin, size_t size) {
+            volatile uint8_t* pointer = begin;
+            size_t step = getPageSize();
+            for (size_t offset = 0; offset < size; offset += step) {
+                pointer[offset] = 0;
+            }
+        }
+
+        // Acquiring Memory
+        HugePageStore::Mapping HugePageStore::map(size_t size, bool prefault) {
+            size_t hugePageSize = getHugePageSize();
+            size = alignUp(size ? size : 1, hugePageSize);
+
+            #ifdef _WIN32
+                // Large pages are locked in memory; no need to prefault them.
+                void* region = VirtualAlloc(nullptr, size,
+                        MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                        PAGE_READWRITE);
+                if (region)
+                    return Mapping {static_cast<uint8_t*>(region), size,
+                            EXPLICIT};
+
+                region = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT,
+                        PAGE_READWRITE);
+                if (region == nullptr)
+                    return Mapping {nullptr, 0, NORMAL};
+                if (prefault)
+                    prefaultRange(static_cast<uint8_t*>(region), size);
+                return Mapping {static_cast<uint8_t*>(region), size, NORMAL};
+            #else
+                // First, try for explicitly reserved huge pages.  These fail
+                // immediately if the system doesn't have enough of them.
+                #ifdef MAP_HUGETLB
+                    int hugeFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+                    #ifdef MAP_POPULATE
+                        if (prefault)
+                            hugeFlags |= MAP_POPULATE;
+                    #endif
+                    void* huge = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            hugeFlags, -1, 0);
+                    if (huge != MAP_FAILED)
+                        return Mapping {static_cast<uint8_t*>(huge), size,
+                                EXPLICIT};
+                #endif
+
+                // Otherwise map normal pages aligned to a huge page boundary
+                // (so the kernel can promote them) and trim the excess.
+                void* raw = mmap(nullptr, size + hugePageSize,
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1, 0);
+                if (raw == MAP_FAILED)
+                    return Mapping {nullptr, 0, NORMAL};
+
+                uint8_t* begin = static_cast<uint8_t*>(raw);
+                uint8_t* region = alignUp(begin, hugePageSize);
+                size_t head = static_cast<size_t>(region - begin);
+                if (head != 0)
+                    munmap(begin, head);
+                if (hugePageSize - head != 0)
+                    munmap(region + size, hugePageSize - head);
+
+                PageKind kind = NORMAL;
+                #ifdef MADV_HUGEPAGE
+                    if (madvise(region, size, MADV_HUGEPAGE) == 0)
+                        kind = TRANSPARENT;
+                #endif
+
+                // MAP_POPULATE would fault in small pages before the hint
+                // above is applied, so fault them in by hand.
+                if (prefault)
+                    prefaultRange(region, size);
+
+                return Mapping {region, size, kind};
+            #endif
+        }
+
+        // Constructors
+        HugePageStore::HugePageStore() : HugePageStore(getHugePageSize()) {}
+        HugePageStore::HugePageStore(size_t size, bool prefault) :
+                HugePageStore(map(size, prefault)) {}
+        HugePageStore::HugePageStore(const Mapping& mapping) :
+                IStore(mapping.size, getPageAlignment()),
+                _region(mapping.region), _kind(mapping.kind) {}
+        HugePageStore::~HugePageStore() {
+            if (_region == nullptr)
+                return;
+
+            #ifdef _WIN32
+                VirtualFree(_region, 0, MEM_RELEASE);
+            #else
+                munmap(_region, SIZE);
+            #endif
+        }
+
+        uint8_t* HugePageStore::getRawStorage() {
+            return _region;
+        }
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ *  @file MappedFileStore.cpp
+ *  @brief Implements: libxaos-core:memory/store/impl/MappedFileStore.h
+ *
+ *  This file provides implementations for the MappedFileStore class.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/store/impl/MappedFileStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/pages.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Mapping Files
+        MappedFileStore::Mapping MappedFileStore::map(const char* path,
+                Mode mode) {
+            if (path == nullptr)
+                return Mapping {nullptr, 0};
+
+            #ifdef _WIN32
+                HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ,
+                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                        nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                    return Mapping {nullptr, 0};
+
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+                    CloseHandle(file);
+                    return Mapping {nullptr, 0};
+                }
+
+                // The view keeps the file open; the handles can go.
+                HANDLE mapping = CreateFileMappingA(file, nullptr,
+                        mode == READ_ONLY ? PAGE_READONLY : PAGE_WRITECOPY,
+                        0, 0, nullptr);
+                CloseHandle(file);
+                if (mapping == nullptr)
+                    return Mapping {nullptr, 0};
+
+                void* region = MapViewOfFile(mapping,
+                        mode == READ_ONLY ? FILE_MAP_READ : FILE_MAP_COPY,
+                        0, 0, 0);
+                CloseHandle(mapping);
+                if (region == nullptr)
+                    return Mapping {nullptr, 0};
+                return Mapping {static_cast<uint8_t*>(region),
+                        static_cast<size_t>(size.QuadPart)};
+            #else
+                int file = open(path, O_RDONLY);
+                if (file < 0)
+                    return Mapping {nullptr, 0};
+
+                struct stat status;
+                if (fstat(file, &status) != 0 || status.st_size <= 0) {
+                    close(file);
+                    return Mapping {nullptr, 0};
+                }
+
+                // The mapping keeps the file open; the descriptor can go.
+                size_t size = static_cast<size_t>(status.st_size);
+                void* region = mmap(nullptr, size, mode == READ_ONLY ?
+                        PROT_READ : PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                        file, 0);
+                close(file);
+                if (region == MAP_FAILED)
+                    return Mapping {nullptr, 0};
+                return Mapping {static_cast<uint8_t*>(region), size};
+            #endif
+        }
+
+        // Constructors
+        MappedFileStore::MappedFileStore(const char* path, Mode mode,
+                Access access, bool prefetchAll) :
+                MappedFileStore(map(path, mode), mode, access, prefetchAll) {}
+        MappedFileStore::MappedFileStore(const Mapping& mapping, Mode mode,
+                Access access, bool prefetchAll) :
+                IStore(mapping.size, getPageAlignment()),
+                _region(mapping.region), _mode(mode) {
+            if (access != NORMAL)
+                advise(access);
+            if (prefetchAll)
+                prefetch(0, SIZE);
+        }
+        MappedFileStore::~MappedFileStore() {
+            if (_region == nullptr)
+                return;
+
+            #ifdef _WIN32
+                UnmapViewOfFile(_region);
+            #else
+                munmap(_region, SIZE);
+            #endif
+        }
+
+        uint8_t* MappedFileStore::getRawStorage() {
+            return _region;
+        }
+
+        // Hints
+        void MappedFileStore::advise(Access access) {
+            if (_region == nullptr)
+                return;
+
+            #ifdef _WIN32
+                (void) access; // Windows has no equivalent.
+            #else
+                int advice = MADV_NORMAL;
+                if (access == SEQUENTIAL)
+                    advice = MADV_SEQUENTIAL;
+                else if (access == RANDOM)
+                    advice = MADV_RANDOM;
+                madvise(_region, SIZE, advice);
+            #endif
+        }
+        void MappedFileStore::prefetch(size_t offset, size_t size) {
+            if (_region == nullptr || offset >= SIZE)
+                return;
+            if (size > SIZE - offset)
+                size = SIZE - offset;
+
+            // The hint has to start on a page boundary.
+            uint8_t* begin = alignDown(_region + offset, getPageSize());
+            size += static_cast<size_t>(_region + offset - begin);
+
+            #ifdef _WIN32
+                WIN32_MEMORY_RANGE_ENTRY range {begin, size};
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+            #else
+                madvise(begin, size, MADV_WILLNEED);
+            #endif
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ *  @file NumaStore.cpp
+ *  @brief Implements: libxaos-core:memory/store/impl/NumaStore.h
+ *
+ *  This file provides implementations for the NumaStore class.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/store/impl/NumaStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/numa.h"
+#include "memory/utility/pages.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Touches every page so they're all faulted in now rather than later.
+        static void prefaultRange(uint8_t* begin, size_t size) {
+            volatile uint8_t* pointer = begin;
+            size_t step = getPageSize();
+            for (size_t offset = 0; offset < size; offset += step) {
+                pointer[offset] = 0;
+            }
+        }
+
+        // Acquiring Memory
+        NumaStore::Mapping NumaStore::map(size_t size, size_t node,
+                bool prefault) {
+            size = alignUp(size ? size : 1, getPageSize());
+            if (node >= getNumaNodeCount())
+                node = 0;
+
+            #ifdef _WIN32
+                void* region = VirtualAllocExNuma(GetCurrentProcess(),
+                        nullptr, size, MEM_RESERVE | MEM_COMMIT,
+                        PAGE_READWRITE, static_cast<DWORD>(node));
+                bool bound = region != nullptr;
+                if (region == nullptr)
+                    region = VirtualAlloc(nullptr, size,
+                            MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+                if (region == nullptr)
+                    return Mapping {nullptr, 0, node, false};
+            #else
+                void* region = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (region == MAP_FAILED)
+                    return Mapping {nullptr, 0, node, false};
+
+                // Nothing has been touched yet, so nothing has to move.
+                bool bound = bindToNumaNode(region, size, node);
+            #endif
+
+            if (prefault)
+                prefaultRange(static_cast<uint8_t*>(region), size);
+            return Mapping {static_cast<uint8_t*>(region), size, node, bound};
+        }
+
+        // Constructors
+        NumaStore::NumaStore(size_t size, size_t node, bool prefault) :
+                NumaStore(map(size, node, prefault)) {}
+        NumaStore::NumaStore(const Mapping& mapping) :
+                IStore(mapping.size, getPageAlignment()),
+                _region(mapping.region), _node(mapping.node),
+                _bound(mapping.bound) {}
+        NumaStore::~NumaStore() {
+            if (_region == nullptr)
+                return;
+
+            #ifdef _WIN32
+                VirtualFree(_region, 0, MEM_RELEASE);
+            #else
+                munmap(_region, SIZE);
+            #endif
+        }
+
+        uint8_t* NumaStore::getRawStorage() {
+            return _region;
+        }
+    }
+}
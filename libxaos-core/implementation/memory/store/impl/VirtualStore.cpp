@@ -0,0 +1,130 @@
+/**
+ *  @file VirtualStore.cpp
+ *  @brief Implements: libxaos-core:memory/store/impl/VirtualStore.h
+ *
+ *  This file provides implementations for the VirtualStore class.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/pages.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        constexpr const size_t VirtualStore::DEFAULT_RESERVE;
+        constexpr const size_t VirtualStore::DEFAULT_GROWTH;
+
+        // Helpers - talk to the OS.  Only visible here.
+        static uint8_t* reserveRange(size_t size) {
+            if (size == 0)
+                return nullptr;
+
+            #ifdef _WIN32
+                void* region = VirtualAlloc(nullptr, size, MEM_RESERVE,
+                        PAGE_NOACCESS);
+                return static_cast<uint8_t*>(region);
+            #else
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+                #ifdef MAP_NORESERVE
+                    flags |= MAP_NORESERVE;
+                #endif
+                void* region = mmap(nullptr, size, PROT_NONE, flags, -1, 0);
+                if (region == MAP_FAILED)
+                    return nullptr;
+                return static_cast<uint8_t*>(region);
+            #endif
+        }
+        static bool commitRange(uint8_t* begin, size_t size) {
+            #ifdef _WIN32
+                return VirtualAlloc(begin, size, MEM_COMMIT, PAGE_READWRITE)
+                        != nullptr;
+            #else
+                return mprotect(begin, size, PROT_READ | PROT_WRITE) == 0;
+            #endif
+        }
+        static void decommitRange(uint8_t* begin, size_t size) {
+            #ifdef _WIN32
+                VirtualFree(begin, size, MEM_DECOMMIT);
+            #else
+                // Mapping fresh PROT_NONE pages over the range drops the old
+                // pages (and their RSS) in a single call.
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+                #ifdef MAP_NORESERVE
+                    flags |= MAP_NORESERVE;
+                #endif
+                mmap(begin, size, PROT_NONE, flags, -1, 0);
+            #endif
+        }
+        static void releaseRange(uint8_t* begin, size_t size) {
+            #ifdef _WIN32
+                (void) size;
+                VirtualFree(begin, 0, MEM_RELEASE);
+            #else
+                munmap(begin, size);
+            #endif
+        }
+
+        // Constructors
+        VirtualStore::VirtualStore() : VirtualStore(DEFAULT_RESERVE) {}
+        VirtualStore::VirtualStore(size_t size, size_t growth) :
+                VirtualStore(reserveRange(
+                        alignUp(size, getReserveGranularity())),
+                        alignUp(size, getReserveGranularity()),
+                        alignUp(growth ? growth : 1, getPageSize())) {}
+        VirtualStore::VirtualStore(uint8_t* region, size_t size,
+                size_t growth) :
+                IStore(region ? size : 0, getPageAlignment()),
+                _region(region), _committed(0), _growth(growth) {}
+        VirtualStore::~VirtualStore() {
+            if (_region)
+                releaseRange(_region, SIZE);
+        }
+
+        uint8_t* VirtualStore::getRawStorage() {
+            return _region;
+        }
+
+        // Committing
+        bool VirtualStore::commit(size_t size) {
+            if (size <= _committed)
+                return true;
+            if (size > SIZE)
+                return false;
+
+            // Grow by at least our granularity, but never past our range.
+            size_t target = alignUp(size, getPageSize());
+            if (target - _committed < _growth)
+                target = _committed + _growth;
+            if (target > SIZE)
+                target = SIZE;
+
+            if (!commitRange(_region + _committed, target - _committed))
+                return false;
+
+            _committed = target;
+            return true;
+        }
+        size_t VirtualStore::getCommitted() const {
+            return _committed;
+        }
+        void VirtualStore::decommit() {
+            if (_committed == 0)
+                return;
+
+            decommitRange(_region, _committed);
+            _committed = 0;
+        }
+    }
+}
@@ -0,0 +1,253 @@
+/**
+ *  @file bulk.cpp
+ *  @brief Implements: libxaos-core:memory/utility/bulk.h
+ *
+ *  This file provides implementations for the bulk memory kernels.
+ *
+ *  The streaming kernels align the destination first (with a plain copy or
+ *  fill of the few leading bytes), stream four registers at a time, then
+ *  finish the tail with a plain copy or fill.  The source is read unaligned.
+ *
+ *  SSE2 is part of x86_64, so its kernels are always built there.  The AVX
+ *  kernels are built with a target attribute (no -mavx needed) and are only
+ *  called once the CPU (and OS) are known to support AVX.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "memory/utility/alignment.h"
+#include "memory/utility/bulk.h"
+#include "utility/cpu.h"
+
+#if defined(LIBXAOS_FLAG_CPU_INTEL) && (defined(__SSE2__) || \
+        defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define LIBXAOS_BULK_SSE2
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define LIBXAOS_BULK_TARGET_AVX
+    #else
+        #define LIBXAOS_BULK_TARGET_AVX __attribute__((target("avx")))
+    #endif
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Kernels!  Only visible here.
+        namespace {
+            #ifdef LIBXAOS_BULK_SSE2
+                //! How far ahead compare() prefetches.
+                constexpr size_t PREFETCH_DISTANCE = 512;
+
+                // SSE2
+                void streamCopySSE2(uint8_t* destination,
+                        const uint8_t* source, size_t size) {
+                    size_t head = getAlignmentOffset(destination, 16);
+                    memcpy(destination, source, head);
+                    destination += head;
+                    source += head;
+                    size -= head;
+
+                    size_t body = alignDown(size, 64);
+                    for (size_t i = 0; i < body; i += 64) {
+                        const __m128i* from =
+                                reinterpret_cast<const __m128i*>(source + i);
+                        __m128i* to = reinterpret_cast<__m128i*>(
+                                destination + i);
+                        __m128i a = _mm_loadu_si128(from);
+                        __m128i b = _mm_loadu_si128(from + 1);
+                        __m128i c = _mm_loadu_si128(from + 2);
+                        __m128i d = _mm_loadu_si128(from + 3);
+                        _mm_stream_si128(to, a);
+                        _mm_stream_si128(to + 1, b);
+                        _mm_stream_si128(to + 2, c);
+                        _mm_stream_si128(to + 3, d);
+                    }
+                    _mm_sfence();
+                    memcpy(destination + body, source + body, size - body);
+                }
+                void streamFillSSE2(uint8_t* destination, uint8_t value,
+                        size_t size) {
+                    size_t head = getAlignmentOffset(destination, 16);
+                    memset(destination, value, head);
+                    destination += head;
+                    size -= head;
+
+                    __m128i fill = _mm_set1_epi8(static_cast<char>(value));
+                    size_t body = alignDown(size, 64);
+                    for (size_t i = 0; i < body; i += 64) {
+                        __m128i* to = reinterpret_cast<__m128i*>(
+                                destination + i);
+                        _mm_stream_si128(to, fill);
+                        _mm_stream_si128(to + 1, fill);
+                        _mm_stream_si128(to + 2, fill);
+                        _mm_stream_si128(to + 3, fill);
+                    }
+                    _mm_sfence();
+                    memset(destination + body, value, size - body);
+                }
+                int prefetchCompareSSE2(const uint8_t* left,
+                        const uint8_t* right, size_t size) {
+                    size_t body = alignDown(size, 64);
+                    for (size_t i = 0; i < body; i += 64) {
+                        if (i + PREFETCH_DISTANCE < size) {
+                            _mm_prefetch(reinterpret_cast<const char*>(
+                                    left + i + PREFETCH_DISTANCE),
+                                    _MM_HINT_NTA);
+                            _mm_prefetch(reinterpret_cast<const char*>(
+                                    right + i + PREFETCH_DISTANCE),
+                                    _MM_HINT_NTA);
+                        }
+
+                        const __m128i* a =
+                                reinterpret_cast<const __m128i*>(left + i);
+                        const __m128i* b =
+                                reinterpret_cast<const __m128i*>(right + i);
+                        __m128i equal = _mm_and_si128(
+                                _mm_and_si128(_mm_cmpeq_epi8(
+                                        _mm_loadu_si128(a),
+                                        _mm_loadu_si128(b)),
+                                _mm_cmpeq_epi8(_mm_loadu_si128(a + 1),
+                                        _mm_loadu_si128(b + 1))),
+                                _mm_and_si128(_mm_cmpeq_epi8(
+                                        _mm_loadu_si128(a + 2),
+                                        _mm_loadu_si128(b + 2)),
+                                _mm_cmpeq_epi8(_mm_loadu_si128(a + 3),
+                                        _mm_loadu_si128(b + 3))));
+
+                        // Let memcmp work out which way they differ.
+                        if (_mm_movemask_epi8(equal) != 0xFFFF)
+                            return memcmp(left + i, right + i, 64);
+                    }
+                    return memcmp(left + body, right + body, size - body);
+                }
+
+                // AVX
+                LIBXAOS_BULK_TARGET_AVX
+                void streamCopyAVX(uint8_t* destination,
+                        const uint8_t* source, size_t size) {
+                    size_t head = getAlignmentOffset(destination, 32);
+                    memcpy(destination, source, head);
+                    destination += head;
+                    source += head;
+                    size -= head;
+
+                    size_t body = alignDown(size, 128);
+                    for (size_t i = 0; i < body; i += 128) {
+                        const __m256i* from =
+                                reinterpret_cast<const __m256i*>(source + i);
+                        __m256i* to = reinterpret_cast<__m256i*>(
+                                destination + i);
+                        __m256i a = _mm256_loadu_si256(from);
+                        __m256i b = _mm256_loadu_si256(from + 1);
+                        __m256i c = _mm256_loadu_si256(from + 2);
+                        __m256i d = _mm256_loadu_si256(from + 3);
+                        _mm256_stream_si256(to, a);
+                        _mm256_stream_si256(to + 1, b);
+                        _mm256_stream_si256(to + 2, c);
+                        _mm256_stream_si256(to + 3, d);
+                    }
+                    _mm_sfence();
+                    _mm256_zeroupper();
+                    memcpy(destination + body, source + body, size - body);
+                }
+                LIBXAOS_BULK_TARGET_AVX
+                void streamFillAVX(uint8_t* destination, uint8_t value,
+                        size_t size) {
+                    size_t head = getAlignmentOffset(destination, 32);
+                    memset(destination, value, head);
+                    destination += head;
+                    size -= head;
+
+                    __m256i fill = _mm256_set1_epi8(static_cast<char>(value));
+                    size_t body = alignDown(size, 128);
+                    for (size_t i = 0; i < body; i += 128) {
+                        __m256i* to = reinterpret_cast<__m256i*>(
+                                destination + i);
+                        _mm256_stream_si256(to, fill);
+                        _mm256_stream_si256(to + 1, fill);
+                        _mm256_stream_si256(to + 2, fill);
+                        _mm256_stream_si256(to + 3, fill);
+                    }
+                    _mm_sfence();
+                    _mm256_zeroupper();
+                    memset(destination + body, value, size - body);
+                }
+
+                // Feature Detection
+                bool hasAVX() {
+                    #ifdef _MSC_VER
+                        // CPUID.1:ECX has OSXSAVE (27) and AVX (28); XCR0
+                        // must show the OS saves the XMM and YMM state.
+                        int info[4];
+                        __cpuid(info, 1);
+                        if ((info[2] & (1 << 27)) == 0 ||
+                                (info[2] & (1 << 28)) == 0)
+                            return false;
+                        return (_xgetbv(0) & 0x6) == 0x6;
+                    #else
+                        __builtin_cpu_init();
+                        return __builtin_cpu_supports("avx");
+                    #endif
+                }
+            #endif
+        }
+
+        BulkKernel getBulkKernel() {
+            #ifdef LIBXAOS_BULK_SSE2
+                static const BulkKernel kernel = hasAVX() ?
+                        BULK_KERNEL_AVX : BULK_KERNEL_SSE2;
+                return kernel;
+            #else
+                return BULK_KERNEL_PLAIN;
+            #endif
+        }
+
+        void bulkCopy(void* destination, const void* source, size_t size) {
+            uint8_t* to = static_cast<uint8_t*>(destination);
+            const uint8_t* from = static_cast<const uint8_t*>(source);
+            assert(to + size <= from || from + size <= to); // No overlaps!
+
+            #ifdef LIBXAOS_BULK_SSE2
+                if (size >= STREAMING_THRESHOLD) {
+                    if (getBulkKernel() == BULK_KERNEL_AVX)
+                        streamCopyAVX(to, from, size);
+                    else
+                        streamCopySSE2(to, from, size);
+                    return;
+                }
+            #endif
+            memcpy(to, from, size);
+        }
+        void bulkFill(void* destination, uint8_t value, size_t size) {
+            uint8_t* to = static_cast<uint8_t*>(destination);
+
+            #ifdef LIBXAOS_BULK_SSE2
+                if (size >= STREAMING_THRESHOLD) {
+                    if (getBulkKernel() == BULK_KERNEL_AVX)
+                        streamFillAVX(to, value, size);
+                    else
+                        streamFillSSE2(to, value, size);
+                    return;
+                }
+            #endif
+            memset(to, value, size);
+        }
+        void bulkZero(void* destination, size_t size) {
+            bulkFill(destination, 0, size);
+        }
+        int bulkCompare(const void* left, const void* right, size_t size) {
+            #ifdef LIBXAOS_BULK_SSE2
+                if (size >= STREAMING_THRESHOLD)
+                    return prefetchCompareSSE2(
+                            static_cast<const uint8_t*>(left),
+                            static_cast<const uint8_t*>(right), size);
+            #endif
+            return memcmp(left, right, size);
+        }
+    }
+}
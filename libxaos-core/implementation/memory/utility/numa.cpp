@@ -0,0 +1,126 @@
+/**
+ *  @file numa.cpp
+ *  @brief Implements: libxaos-core:memory/utility/numa.h
+ *
+ *  This file provides implementations for the NUMA helpers.
+ *
+ *  On Linux the mbind/set_mempolicy/getcpu system calls are made directly so
+ *  there's no dependency on libnuma (or its headers).
+ */
+
+#include <cstddef>
+#include <cstdio>
+
+#include "memory/utility/numa.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        // Helpers!  Only visible here.
+        namespace {
+            #if defined(__linux__)
+                // From <linux/mempolicy.h>.
+                constexpr int MPOL_PREFERRED = 1;
+                constexpr int MPOL_BIND = 2;
+                constexpr unsigned int MPOL_MF_MOVE = 1 << 1;
+
+                constexpr size_t BITS_PER_LONG = sizeof(unsigned long) * 8;
+                constexpr size_t MASK_LONGS =
+                        (MAX_NUMA_NODES + BITS_PER_LONG - 1) / BITS_PER_LONG;
+
+                // A mask holding only the provided node.
+                struct NodeMask {
+                    unsigned long bits[MASK_LONGS];
+                };
+                NodeMask makeNodeMask(size_t node) {
+                    NodeMask mask {};
+                    mask.bits[node / BITS_PER_LONG] =
+                            1UL << (node % BITS_PER_LONG);
+                    return mask;
+                }
+            #endif
+        }
+
+        size_t getNumaNodeCount() {
+            static const size_t nodeCount = []() -> size_t {
+                size_t count = 1;
+                #if defined(_WIN32)
+                    ULONG highest = 0;
+                    if (GetNumaHighestNodeNumber(&highest))
+                        count = highest + 1;
+                #elif defined(__linux__)
+                    // Looks like "0", "0-1" or "0,2-3".  The highest node
+                    // number (plus one) is what we want.
+                    FILE* file = fopen("/sys/devices/system/node/online", "r");
+                    if (file) {
+                        unsigned long node = 0;
+                        int separator = 0;
+                        while (fscanf(file, "%lu", &node) == 1) {
+                            if (node + 1 > count)
+                                count = node + 1;
+                            separator = fgetc(file);
+                            if (separator != ',' && separator != '-')
+                                break;
+                        }
+                        fclose(file);
+                    }
+                #endif
+                return count < MAX_NUMA_NODES ? count : MAX_NUMA_NODES;
+            }();
+            return nodeCount;
+        }
+
+        size_t getCurrentNumaNode() {
+            size_t node = 0;
+            #if defined(_WIN32)
+                PROCESSOR_NUMBER processor;
+                USHORT current = 0;
+                GetCurrentProcessorNumberEx(&processor);
+                if (GetNumaProcessorNodeEx(&processor, &current))
+                    node = current;
+            #elif defined(__linux__) && defined(SYS_getcpu)
+                unsigned int cpu = 0;
+                unsigned int current = 0;
+                if (syscall(SYS_getcpu, &cpu, &current, nullptr) == 0)
+                    node = current;
+            #endif
+            return node < getNumaNodeCount() ? node : 0;
+        }
+
+        bool bindToNumaNode(void* pointer, size_t size, size_t node) {
+            if (pointer == nullptr || node >= getNumaNodeCount())
+                return false;
+
+            #if defined(__linux__) && defined(SYS_mbind)
+                NodeMask mask = makeNodeMask(node);
+                return syscall(SYS_mbind, pointer, size, MPOL_BIND,
+                        mask.bits, MAX_NUMA_NODES + 1, MPOL_MF_MOVE) == 0;
+            #else
+                // Windows places memory when it's allocated (see
+                // VirtualAllocExNuma); nothing else can be bound.
+                (void) size;
+                return false;
+            #endif
+        }
+
+        bool setPreferredNumaNode(size_t node) {
+            if (node >= getNumaNodeCount())
+                return false;
+
+            #if defined(__linux__) && defined(SYS_set_mempolicy)
+                NodeMask mask = makeNodeMask(node);
+                return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.bits,
+                        MAX_NUMA_NODES + 1) == 0;
+            #else
+                return false;
+            #endif
+        }
+    }
+}
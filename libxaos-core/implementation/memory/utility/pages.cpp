@@ -0,0 +1,82 @@
+/**
+ *  @file pages.cpp
+ *  @brief Implements: libxaos-core:memory/utility/pages.h
+ *
+ *  This file provides implementations for the page helpers.
+ */
+
+#include <cstddef>
+#include <cstdio>
+
+#include "memory/utility/pages.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace libxaos {
+    namespace memory {
+
+        size_t getPageSize() {
+            static const size_t pageSize = []() -> size_t {
+                #ifdef _WIN32
+                    SYSTEM_INFO info;
+                    GetSystemInfo(&info);
+                    return info.dwPageSize;
+                #else
+                    long size = sysconf(_SC_PAGESIZE);
+                    return size > 0 ? static_cast<size_t>(size) : 4096;
+                #endif
+            }();
+            return pageSize;
+        }
+
+        size_t getReserveGranularity() {
+            #ifdef _WIN32
+                static const size_t granularity = []() -> size_t {
+                    SYSTEM_INFO info;
+                    GetSystemInfo(&info);
+                    return info.dwAllocationGranularity;
+                }();
+                return granularity;
+            #else
+                return getPageSize();
+            #endif
+        }
+
+        size_t getHugePageSize() {
+            static const size_t hugePageSize = []() -> size_t {
+                size_t size = 2 * 1024 * 1024;
+                #if defined(_WIN32)
+                    SIZE_T large = GetLargePageMinimum();
+                    if (large != 0)
+                        size = large;
+                #elif defined(__linux__)
+                    // Look for "Hugepagesize:    2048 kB"
+                    FILE* file = fopen("/proc/meminfo", "r");
+                    if (file) {
+                        char line[128];
+                        unsigned long kilobytes = 0;
+                        while (fgets(line, sizeof(line), file)) {
+                            if (sscanf(line, "Hugepagesize: %lu kB",
+                                    &kilobytes) == 1 && kilobytes != 0) {
+                                size = kilobytes * 1024;
+                                break;
+                            }
+                        }
+                        fclose(file);
+                    }
+                #endif
+                return size;
+            }();
+            return hugePageSize;
+        }
+
+        unsigned short getPageAlignment() {
+            size_t size = getPageSize();
+            return static_cast<unsigned short>(size < 32768 ? size : 32768);
+        }
+    }
+}
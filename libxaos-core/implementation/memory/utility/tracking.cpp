@@ -0,0 +1,135 @@
+/**
+ *  @file tracking.cpp
+ *  @brief Implements: libxaos-core:memory/utility/tracking.h
+ *
+ *  This file provides implementations for the allocation tracking helpers.
+ *  Every counter is a relaxed atomic; a snapshot may be slightly torn across
+ *  counters, but no update is ever lost.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Helpers!  Only visible here.
+        namespace {
+            //! Everything recorded for a single tag.
+            struct TagRecord {
+                std::atomic<const char*> name;
+                std::atomic<size_t> liveBytes;
+                std::atomic<size_t> peakBytes;
+                std::atomic<size_t> allocationCount;
+                std::atomic<size_t> deallocationCount;
+                std::atomic<size_t> failureCount;
+                std::atomic<size_t> currentFrameCount;
+                std::atomic<size_t> currentFrameBytes;
+                std::atomic<size_t> frameCount;
+                std::atomic<size_t> frameBytes;
+                std::atomic<size_t> budget;
+            };
+
+            // Zero initialized (statically) so allocators may record before
+            // main() and during static destruction.
+            TagRecord records[MAX_MEMORY_TAGS];
+            std::atomic<size_t> tagCount {1};
+            std::mutex registrationMutex;
+
+            constexpr std::memory_order RELAXED = std::memory_order_relaxed;
+
+            inline TagRecord& getRecord(MemoryTag tag) {
+                assert(tag < MAX_MEMORY_TAGS); // Not a tag!
+                return records[tag];
+            }
+        }
+
+        // Registration
+        MemoryTag registerMemoryTag(const char* name) {
+            assert(name); // Tags need names!
+            std::lock_guard<std::mutex> lock {registrationMutex};
+
+            size_t count = tagCount.load();
+            for (size_t i = 1; i < count; i++) {
+                if (strcmp(records[i].name.load(), name) == 0)
+                    return static_cast<MemoryTag>(i);
+            }
+            if (count >= MAX_MEMORY_TAGS)
+                return MEMORY_TAG_UNTAGGED; // Out of tags!
+
+            records[count].name = name;
+            tagCount = count + 1;
+            return static_cast<MemoryTag>(count);
+        }
+        size_t getMemoryTagCount() {
+            return tagCount.load();
+        }
+        void setMemoryBudget(MemoryTag tag, size_t budget) {
+            getRecord(tag).budget.store(budget, RELAXED);
+        }
+
+        // Queries
+        MemoryTagStatistics getMemoryTagStatistics(MemoryTag tag) {
+            TagRecord& record = getRecord(tag);
+            const char* name = record.name.load();
+
+            MemoryTagStatistics statistics;
+            statistics.name = tag == MEMORY_TAG_UNTAGGED ? "untagged" :
+                    (name ? name : "unregistered");
+            statistics.liveBytes = record.liveBytes.load(RELAXED);
+            statistics.peakBytes = record.peakBytes.load(RELAXED);
+            statistics.allocationCount = record.allocationCount.load(RELAXED);
+            statistics.deallocationCount =
+                    record.deallocationCount.load(RELAXED);
+            statistics.failureCount = record.failureCount.load(RELAXED);
+            statistics.frameAllocationCount = record.frameCount.load(RELAXED);
+            statistics.frameAllocatedBytes = record.frameBytes.load(RELAXED);
+            statistics.budget = record.budget.load(RELAXED);
+            statistics.overBudget = statistics.budget != 0 &&
+                    statistics.peakBytes > statistics.budget;
+            return statistics;
+        }
+
+        // Frames
+        void tickMemoryFrame() {
+            size_t count = tagCount.load();
+            for (size_t i = 0; i < count; i++) {
+                TagRecord& record = records[i];
+                record.frameCount.store(
+                        record.currentFrameCount.exchange(0, RELAXED),
+                        RELAXED);
+                record.frameBytes.store(
+                        record.currentFrameBytes.exchange(0, RELAXED),
+                        RELAXED);
+            }
+        }
+
+        // Recording
+        #ifdef LIBXAOS_FLAG_MEMORY_TRACKING
+            void recordAllocation(MemoryTag tag, size_t size, size_t count) {
+                TagRecord& record = getRecord(tag);
+                size_t live = record.liveBytes.fetch_add(size, RELAXED) + size;
+                record.allocationCount.fetch_add(count, RELAXED);
+                record.currentFrameCount.fetch_add(count, RELAXED);
+                record.currentFrameBytes.fetch_add(size, RELAXED);
+
+                // Raise the peak (if someone else hasn't already).
+                size_t peak = record.peakBytes.load(RELAXED);
+                while (live > peak && !record.peakBytes.compare_exchange_weak(
+                        peak, live, RELAXED)) {}
+            }
+            void recordDeallocation(MemoryTag tag, size_t size, size_t count) {
+                TagRecord& record = getRecord(tag);
+                record.liveBytes.fetch_sub(size, RELAXED);
+                record.deallocationCount.fetch_add(count, RELAXED);
+            }
+            void recordAllocationFailure(MemoryTag tag, size_t) {
+                getRecord(tag).failureCount.fetch_add(1, RELAXED);
+            }
+        #endif
+    }
+}
@@ -0,0 +1,234 @@
+/**
+ *  @file ConcurrentStringPool.cpp
+ *  @brief Implements: libxaos-core:strings/ConcurrentStringPool.h
+ *
+ *  This file provides implementations for the ConcurrentStringPool class.
+ *
+ *  Strings are laid out exactly as a StringPool lays them out (see
+ *  PooledString::writeEntry()).  A string is written in full before its
+ *  slot's offset is stored (with release semantics), so a reader that sees
+ *  the offset (with acquire semantics) sees the string.
+ *  Slots are only ever filled, never emptied, so a lock-free probe can't be
+ *  fooled by a slot changing under it.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include "memory/store/IStore.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "memory/utility/bulk.h"
+#include "strings/ConcurrentStringPool.h"
+#include "strings/HashedString.h"
+#include "strings/PooledString.h"
+#include "strings/utility/kernels.h"
+
+// Some cpp using statements
+using IStore = libxaos::memory::IStore;
+using VirtualStore = libxaos::memory::VirtualStore;
+using libxaos::memory::recordAllocation;
+using libxaos::memory::recordAllocationFailure;
+
+namespace libxaos {
+    namespace strings {
+
+        // Static Constants
+        constexpr const size_t ConcurrentStringPool::SHARD_COUNT;
+        constexpr const size_t ConcurrentStringPool::DEFAULT_INDEX_RESERVE;
+
+        // Helpers!  Only visible here.
+        namespace {
+            //! log2(SHARD_COUNT)
+            constexpr unsigned int SHARD_BITS = 4;
+            static_assert(size_t(1) << SHARD_BITS ==
+                    ConcurrentStringPool::SHARD_COUNT,
+                    "SHARD_BITS doesn't match SHARD_COUNT!");
+
+            // djb2 barely touches the high bits of short strings, so mix
+            // them in (Fibonacci hashing) before picking a shard.
+            inline size_t getShardIndex(HashType hash) {
+                return static_cast<uint32_t>(hash * 2654435769U) >>
+                        (32 - SHARD_BITS);
+            }
+        }
+
+        // Constructors
+        ConcurrentStringPool::ConcurrentStringPool(IStore* store,
+                IStore* indexStore) : _store(store), _indexStore(indexStore),
+                _begin(store ? store->getRawStorage() : nullptr), _used(0),
+                _committed(store ? store->getCommitted() : 0),
+                _commitMutex(), _shards(), _slotCount(0),
+                _tag(libxaos::memory::MEMORY_TAG_UNTAGGED) {
+            bool provided = _indexStore != nullptr;
+            if (!provided)
+                _indexStore = new VirtualStore(DEFAULT_INDEX_RESERVE);
+
+            // Split the whole index store between the shards.
+            size_t slotCount = _indexStore->SIZE / sizeof(IndexSlot) /
+                    SHARD_COUNT;
+            if (slotCount < 2 || !_indexStore->commit(_indexStore->SIZE))
+                return;
+            _slotCount = 1;
+            while (_slotCount * 2 <= slotCount) {
+                _slotCount *= 2;
+            }
+
+            // Zero is "empty" for both atomics, so clear rather than
+            // construct.  Our own VirtualStore's pages are already zero (and
+            // clearing would touch every one of them), so only a provided
+            // store (which may be reused) is cleared.
+            IndexSlot* slots = reinterpret_cast<IndexSlot*>(
+                    _indexStore->getRawStorage());
+            if (provided)
+                libxaos::memory::bulkZero(slots,
+                        _slotCount * SHARD_COUNT * sizeof(IndexSlot));
+            for (size_t i = 0; i < SHARD_COUNT; i++) {
+                _shards[i].slots = slots + i * _slotCount;
+            }
+        }
+        ConcurrentStringPool::~ConcurrentStringPool() {
+            if (_store)
+                delete _store;
+            if (_indexStore)
+                delete _indexStore;
+        }
+
+        // Index Management
+        ConcurrentStringPool::Shard& ConcurrentStringPool::getShard(
+                HashType hash) const {
+            return _shards[getShardIndex(hash)];
+        }
+        ConcurrentStringPool::IndexSlot* ConcurrentStringPool::findSlot(
+                const Shard& shard, const char* str, size_t length,
+                HashType hash) const {
+            if (_slotCount == 0)
+                return nullptr;
+
+            size_t mask = _slotCount - 1;
+            for (size_t index = hash & mask; ; index = (index + 1) & mask) {
+                IndexSlot* slot = shard.slots + index;
+                size_t offset = slot->offset.load(std::memory_order_acquire);
+                if (offset == 0)
+                    return slot;
+                const char* candidate = reinterpret_cast<const char*>(
+                        _begin) + offset - 1;
+                if (slot->hash.load(std::memory_order_relaxed) == hash &&
+                        PooledString::readHeader(candidate).length ==
+                        length && stringsEqual(candidate, str, length))
+                    return slot;
+            }
+        }
+
+        // Appending - claim the bytes first, then make sure they're backed.
+        size_t ConcurrentStringPool::append(size_t size) {
+            size_t offset = _used.load(std::memory_order_relaxed);
+            do {
+                if (size > _store->SIZE - offset)
+                    return SIZE_MAX;
+            } while (!_used.compare_exchange_weak(offset, offset + size,
+                    std::memory_order_relaxed));
+
+            if (offset + size > _committed.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock {_commitMutex};
+                if (!_store->commit(offset + size))
+                    return SIZE_MAX; // Lost; but the store is out anyway.
+                _committed.store(_store->getCommitted(),
+                        std::memory_order_release);
+            }
+            return offset;
+        }
+
+        // Process Function
+        PooledString ConcurrentStringPool::process(const char* str) {
+            assert(str); // No null strings!
+            assert(strlen(str) > 0); // No empty strings!
+
+            if (str == nullptr || str[0] == '\0')
+                return PooledString{nullptr};
+
+            // Most strings are already here; look without locking.
+            size_t rawSize = stringLength(str);
+            HashType hash = HashedString(str, rawSize).getHash();
+            Shard& shard = getShard(hash);
+            IndexSlot* slot = findSlot(shard, str, rawSize, hash);
+            size_t found = slot ?
+                    slot->offset.load(std::memory_order_acquire) : 0;
+            if (found != 0)
+                return PooledString{reinterpret_cast<char*>(_begin) +
+                        found - 1};
+
+            assert(rawSize <= UINT16_MAX); // REMEMBER THE LIMITS!!
+            uint16_t size = static_cast<uint16_t>(rawSize);
+            size_t entrySize = PooledString::getEntrySize(size);
+
+            // Somebody may have beaten us to it while we weren't looking.
+            std::lock_guard<std::mutex> lock {shard.mutex};
+            slot = findSlot(shard, str, rawSize, hash);
+            found = slot ? slot->offset.load(std::memory_order_relaxed) : 0;
+            if (found != 0)
+                return PooledString{reinterpret_cast<char*>(_begin) +
+                        found - 1};
+
+            size_t offset = SIZE_MAX;
+            if (slot && (shard.count.load(std::memory_order_relaxed) + 1) *
+                    4 <= _slotCount * 3)
+                offset = append(entrySize);
+            if (offset == SIZE_MAX) {
+                recordAllocationFailure(_tag, entrySize);
+                return PooledString{nullptr};
+            }
+
+            char* pooledString = PooledString::writeEntry(_begin + offset,
+                    str, size, hash);
+
+            // Publish it.
+            slot->hash.store(hash, std::memory_order_relaxed);
+            slot->offset.store(offset + sizeof(PooledString::Header) + 1,
+                    std::memory_order_release);
+            shard.count.fetch_add(1, std::memory_order_relaxed);
+
+            recordAllocation(_tag, entrySize);
+            return PooledString{pooledString};
+        }
+
+        bool ConcurrentStringPool::contains(const char* str) const {
+            if (str == nullptr || str[0] == '\0')
+                return false;
+
+            size_t length = stringLength(str);
+            HashType hash = HashedString(str, length).getHash();
+            IndexSlot* slot = findSlot(getShard(hash), str, length, hash);
+            return slot && slot->offset.load(std::memory_order_acquire) != 0;
+        }
+        bool ConcurrentStringPool::contains(const PooledString& str) const {
+            if (!str || str.length() == 0)
+                return false;
+
+            // The length and hash are already stored with the string.
+            IndexSlot* slot = findSlot(getShard(str.getHash()),
+                    str.getCharPointer(), str.length(), str.getHash());
+            return slot && slot->offset.load(std::memory_order_acquire) != 0;
+        }
+
+        // Queries
+        size_t ConcurrentStringPool::getCount() const {
+            size_t count = 0;
+            for (const Shard& shard : _shards) {
+                count += shard.count.load(std::memory_order_relaxed);
+            }
+            return count;
+        }
+
+        // Tracking
+        void ConcurrentStringPool::setMemoryTag(
+                libxaos::memory::MemoryTag tag) {
+            _tag = tag;
+        }
+        libxaos::memory::MemoryTag ConcurrentStringPool::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
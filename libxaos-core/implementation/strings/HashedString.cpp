@@ -5,46 +5,42 @@
  *  This file provides implementations for the HashedString class.
  */
 
+#include <cstddef>
 #include <cstdint>
-#include <cstring>
 
 #include "strings/HashedString.h"
 #include "strings/PooledString.h"
+#include "strings/utility/kernels.h"
+#include "strings/utility/registry.h"
 
 namespace libxaos {
     namespace strings {
 
-        // Unfortunately, this requires knowing the implementation from
-        // the header file.  I could set up a preprocessor define or constexpr,
-        // but I don't want these values in teh public header because I don't
-        // wan't people to feel it's okay to assign them manually.. use the
-        // constants in the class!
-        const HashType HashedString::NULL_STRING_HASH {UINT32_MAX};
-        const HashType HashedString::EMPTY_STRING_HASH {0};
+        // Static Constants
+        constexpr const HashType HashedString::HASH_SEED;
+        constexpr const HashType HashedString::HASH_MULTIPLIER;
+        constexpr const HashType HashedString::NULL_STRING_HASH;
+        constexpr const HashType HashedString::EMPTY_STRING_HASH;
         const HashedString HashedString::NULL_STRING {nullptr};
         const HashedString HashedString::EMPTY_STRING {""};
 
         // Our hashing algorithm.  Only visible here.
         // Algorithm is 'djb2'; Source: http://www.cse.yorku.ca/~oz/hash.html
+        // (FNV-1a-64 with LIBXAOS_FLAG_WIDE_HASHES; Source:
+        // http://www.isthe.com/chongo/tech/comp/fnv/)
         // Some slight modifications:
         // Manually assign to specific values for nullptr and empty string
         // Shift end values slightly if hash overlaps with manually assigned
         // values for NULL_STRING and EMPTY_STRING
-        static HashType hashString(const char* str) {
+        // (HashedString::hash() is the compile-time twin of this; keep them
+        // in step!  hashRange() does the per-character work.)
+        static HashType hashString(const char* str, size_t length) {
             if (str == nullptr)
                 return HashedString::NULL_STRING_HASH;
-            else if (strlen(str) == 0)
+            else if (length == 0)
                 return HashedString::EMPTY_STRING_HASH;
 
-            const unsigned char* hashPtr =
-                    reinterpret_cast<const unsigned char*>(str);
-
-            HashType hash = 5381;
-
-            int c;
-            while ((c = *(hashPtr++))) {
-                hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
-            }
+            HashType hash = hashRange(str, length, HashedString::HASH_SEED);
 
             // Shift our hash slightly if needed
             if (hash == HashedString::NULL_STRING_HASH)
@@ -52,29 +48,19 @@ namespace libxaos {
             else if (hash == HashedString::EMPTY_STRING_HASH)
                 hash++;
 
+            // (Does nothing unless LIBXAOS_FLAG_HASH_REGISTRY is defined.)
+            recordHashedString(hash, str, length);
             return hash;
         }
 
         // Constructors
-        HashedString::HashedString(const char* str) : _hash(hashString(str)) {}
+        HashedString::HashedString(const char* str) :
+                _hash(hashString(str, str ? stringLength(str) : 0)) {}
+        HashedString::HashedString(const char* str, size_t length) :
+                _hash(hashString(str, length)) {}
         HashedString::HashedString(const std::string& str) :
                 HashedString(str.data()) {}
         HashedString::HashedString(const PooledString& str) :
-                HashedString(str.getCharPointer()) {}
-        HashedString::~HashedString() {}
-
-        // Copy / Move Semantics
-        HashedString::HashedString(const HashedString& other) :
-                _hash(other._hash) {}
-        HashedString& HashedString::operator=(const HashedString& other) {
-            _hash = other._hash;
-            return *this;
-        }
-        HashedString::HashedString(HashedString&& other) :
-                _hash(other._hash) {}
-        HashedString& HashedString::operator=(HashedString&& other) {
-            _hash = other._hash;
-            return *this;
-        }
+                _hash(str.getHash()) {}
     }
  }
@@ -6,7 +6,10 @@
  */
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
+#include "memory/utility/alignment.h"
 #include "strings/PooledString.h"
 
 namespace libxaos {
@@ -38,5 +41,21 @@ namespace libxaos {
 
         // Private Constructor
         PooledString::PooledString(char* str) : _string(str) {}
+
+        // Pool Entries
+        size_t PooledString::getEntrySize(size_t length) {
+            return libxaos::memory::alignUp(sizeof(Header) + length + 1,
+                    alignof(Header));
+        }
+        char* PooledString::writeEntry(uint8_t* entry, const char* str,
+                uint16_t length, HashType hash) {
+            Header header {hash, length};
+            memcpy(entry, &header, sizeof(Header));
+            char* characters = reinterpret_cast<char*>(entry +
+                    sizeof(Header));
+            memcpy(characters, str, length);
+            characters[length] = '\0';
+            return characters;
+        }
     }
 }
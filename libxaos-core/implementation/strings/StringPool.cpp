@@ -9,75 +9,206 @@
 #include <cstddef>
 #include <cstdint>
 #include <climits>
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
 #include "memory/store/IStore.h"
-#include "memory/store/impl/StaticStore.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "memory/utility/alignment.h"
+#include "strings/HashedString.h"
 #include "strings/PooledString.h"
 #include "strings/StringPool.h"
+#include "strings/utility/kernels.h"
+#include "utility/cpu.h"
+
+#if defined(_MSC_VER) && defined(LIBXAOS_FLAG_CPU_INTEL)
+    #include <xmmintrin.h>
+#endif
 
 // Some cpp using statements
 using IStore = libxaos::memory::IStore;
+using VirtualStore = libxaos::memory::VirtualStore;
+using libxaos::memory::recordAllocation;
+using libxaos::memory::recordAllocationFailure;
 
 namespace libxaos {
     namespace strings {
 
+        // Static Constants
+        constexpr const size_t StringPool::DEFAULT_INDEX_RESERVE;
+        constexpr const size_t StringPool::BATCH_SIZE;
+        constexpr const size_t StringPool::MAX_STORES;
+        constexpr const uint32_t StringPool::IMAGE_MAGIC;
+        constexpr const uint32_t StringPool::IMAGE_VERSION;
+
+        // Helpers!  Only visible here.
+        namespace {
+            //! The number of slots in a fresh index.
+            constexpr size_t MIN_SLOT_COUNT = 64;
+            // Only a hint; the CPU may ignore it.
+            inline void prefetch(const void* address) {
+                #if defined(_MSC_VER) && defined(LIBXAOS_FLAG_CPU_INTEL)
+                    _mm_prefetch(static_cast<const char*>(address),
+                            _MM_HINT_T0);
+                #elif defined(__GNUC__)
+                    __builtin_prefetch(address);
+                #else
+                    (void) address;
+                #endif
+            }
+
+            //! The fewest slots in an image's index.
+            constexpr size_t MIN_IMAGE_SLOT_COUNT = 16;
+
+            // Images are never grown, so size them for what they hold (at
+            // most three quarters full).
+            size_t getImageSlotCount(size_t count) {
+                size_t slotCount = MIN_IMAGE_SLOT_COUNT;
+                while (slotCount * 3 < count * 4) {
+                    slotCount *= 2;
+                }
+                return slotCount;
+            }
+        }
+
         // Constructors
-        StringPool::StringPool(IStore* store) : _store(store), _count(0U) {}
+        StringPool::StringPool(IStore* store, IStore* indexStore) :
+                _segments(), _segmentCount(0), _factory(nullptr),
+                _indexStore(indexStore), _imageStore(nullptr),
+                _image(nullptr), _count(0U), _slotCount(0),
+                _tag(libxaos::memory::MEMORY_TAG_UNTAGGED) {
+            if (store)
+                _segments[_segmentCount++] = Segment {store, 0};
+            if (_indexStore == nullptr)
+                _indexStore = new VirtualStore(DEFAULT_INDEX_RESERVE);
+            growIndex();
+        }
         StringPool::~StringPool() {
-            if (_store)
-                delete _store;
+            for (size_t i = 0; i < _segmentCount; i++) {
+                delete _segments[i].store;
+            }
+            if (_indexStore)
+                delete _indexStore;
+            if (_imageStore)
+                delete _imageStore;
         }
 
         // Move Semantics (no copying pools!
         StringPool::StringPool(StringPool&& other) :
-                _store(other._store), _count(other._count) {}
+                _segments(), _segmentCount(other._segmentCount),
+                _factory(std::move(other._factory)),
+                _indexStore(other._indexStore),
+                _imageStore(other._imageStore), _image(other._image),
+                _count(other._count), _slotCount(other._slotCount),
+                _tag(other._tag) {
+            std::copy(other._segments, other._segments + _segmentCount,
+                    _segments);
+            other._segmentCount = 0;
+            other._factory = nullptr;
+            other._indexStore = nullptr;
+            other._imageStore = nullptr;
+            other._image = nullptr;
+            other._count = 0;
+            other._slotCount = 0;
+        }
         StringPool& StringPool::operator=(StringPool&& other) {
             if (this != &other) {
-                std::swap(_store, other._store);
-                _count = other._count;
+                std::swap(_segments, other._segments);
+                std::swap(_segmentCount, other._segmentCount);
+                std::swap(_factory, other._factory);
+                std::swap(_indexStore, other._indexStore);
+                std::swap(_imageStore, other._imageStore);
+                std::swap(_image, other._image);
+                std::swap(_count, other._count);
+                std::swap(_slotCount, other._slotCount);
+                std::swap(_tag, other._tag);
             }
             return *this;
         }
 
-        // Helpers! OMG I need them...
-        // So..  this finds a str in the pool starting at the pointer pointed
-        // to by doublePointer.  It checks up to poolSize entries before
-        // returning false.  doublePointer points JUST AFTER the end of the
-        // last string
-        static bool findString(uint8_t** doublePointer, const char* str,
-                unsigned int poolSize) {
+        // Index Management
+        void StringPool::prefetchSlots(HashType hash) const {
+            if (_slotCount > 0)
+                prefetch(reinterpret_cast<const IndexSlot*>(
+                        _indexStore->getRawStorage()) +
+                        (hash & (_slotCount - 1)));
+            if (_image)
+                prefetch(reinterpret_cast<const ImageSlot*>(
+                        reinterpret_cast<const uint8_t*>(_image) +
+                        _image->indexOffset) +
+                        (hash & (_image->slotCount - 1)));
+        }
+        // Linear probing from the hash's home slot.  The index is never
+        // allowed to fill, so this always finds one or the other.
+        StringPool::IndexSlot* StringPool::findSlot(const char* str,
+                size_t length, HashType hash) const {
+            if (_slotCount == 0)
+                return nullptr;
 
-            if (str == nullptr || strcmp(str, "") == 0) {
-                return false;
+            IndexSlot* slots = reinterpret_cast<IndexSlot*>(
+                    _indexStore->getRawStorage());
+            size_t mask = _slotCount - 1;
+            for (size_t index = hash & mask; ; index = (index + 1) & mask) {
+                IndexSlot* slot = slots + index;
+                if (slot->hash == HashedString::EMPTY_STRING_HASH)
+                    return slot;
+                if (slot->hash == hash && PooledString::readHeader(
+                        slot->string).length == length &&
+                        stringsEqual(slot->string, str, length))
+                    return slot;
             }
+        }
+        bool StringPool::growIndex() {
+            size_t slotCount = _slotCount ? _slotCount * 2 : MIN_SLOT_COUNT;
+            if (slotCount > SIZE_MAX / sizeof(IndexSlot) ||
+                    !_indexStore->commit(slotCount * sizeof(IndexSlot)))
+                return false;
 
-            // Step through and see if we can find it
-            unsigned int index = 0;
-            while (index++ < poolSize) {
-                // First, pull out string size
-                uint16_t size = *reinterpret_cast<uint16_t*>(*doublePointer);
-
-                // Step the doublePointer forward
-                *doublePointer += sizeof(uint16_t); // should be 2
-
-                // Just make sure we're using a char*
-                char* cmp = reinterpret_cast<char*>(*doublePointer);
+            // Start over with an empty index and put every string back.
+            _slotCount = slotCount;
+            memset(_indexStore->getRawStorage(), 0,
+                    slotCount * sizeof(IndexSlot));
 
-                // Let strcmp do its thing
-                if (strcmp(str, cmp) == 0) {
-                    // we found it! :D
-                    return true; // the passed in uint8_t* now points at it
-                } else {
-                    // we didn't find it..  increment doublePointer and try
-                    // again...
-                    *doublePointer += size + 1; // string AND null character
+            // (The entries carry their hashes; no need to recompute them.)
+            for (size_t i = 0; i < _segmentCount; i++) {
+                uint8_t* entries = _segments[i].store->getRawStorage();
+                size_t offset = 0;
+                while (offset < _segments[i].used) {
+                    PooledString str {reinterpret_cast<char*>(entries +
+                            offset + sizeof(PooledString::Header))};
+                    *findSlot(str.getCharPointer(), str.length(),
+                            str.getHash()) =
+                            IndexSlot {str.getCharPointer(), str.getHash()};
+                    offset += PooledString::getEntrySize(str.length());
                 }
             }
+            return true;
+        }
 
-            // if we get here we didn't find it
-            return false;
+        // Store Management
+        // Strings only ever go in the newest store; older ones are left
+        // exactly as they are so their strings never move.
+        StringPool::Segment* StringPool::reserve(size_t entrySize) {
+            // (commit() fails if the entry would run past the store's end.)
+            if (_segmentCount > 0) {
+                Segment* segment = _segments + _segmentCount - 1;
+                if (entrySize <= SIZE_MAX - segment->used &&
+                        segment->store->commit(segment->used + entrySize))
+                    return segment;
+            }
+            if (_factory == nullptr || _segmentCount == MAX_STORES)
+                return nullptr;
+
+            IStore* store = _factory(entrySize);
+            if (store == nullptr)
+                return nullptr;
+            if (!store->commit(entrySize)) {
+                delete store; // Too small to be of use
+                return nullptr;
+            }
+            _segments[_segmentCount] = Segment {store, 0};
+            return _segments + _segmentCount++;
         }
 
         // Process Function - the meat of it all
@@ -87,50 +218,275 @@ namespace libxaos {
 
             if (str == nullptr)
                 return PooledString{nullptr};
-            if (strlen(str) == 0)
+            size_t rawSize = stringLength(str);
+            if (rawSize == 0)
                 return PooledString{nullptr};
 
-            // Grab our pointer to our storage and use helper method
-            uint8_t* pointer = _store->getRawStorage();
-            if (findString(&pointer, str, _count)) {
-                // Our find found it!  Return it as a PooledString
-                return PooledString{reinterpret_cast<char*>(pointer)};
+            return intern(str, rawSize, HashedString(str, rawSize).getHash());
+        }
+
+        // Batch Processing
+        // Each batch is hashed first, prefetching every string's slots, so
+        // the cache misses of the lookups overlap rather than following one
+        // another.  The index is grown for the whole batch up front (so it
+        // isn't rebuilt under the prefetches) and new strings are appended
+        // in order as they're found missing.
+        size_t StringPool::process(const char* const* strings, size_t count,
+                PooledString* results) {
+            assert(count == 0 || (strings && results)); // Nowhere to go!
+
+            size_t pooled = 0;
+            size_t lengths[BATCH_SIZE];
+            HashType hashes[BATCH_SIZE];
+            for (size_t first = 0; first < count; first += BATCH_SIZE) {
+                size_t batch = std::min(BATCH_SIZE, count - first);
+                while (_slotCount > 0 && (size_t(_count) + batch) * 4 >
+                        _slotCount * 3 && growIndex()) {}
+
+                for (size_t i = 0; i < batch; i++) {
+                    const char* str = strings[first + i];
+                    assert(str); // No null strings!
+                    assert(str[0] != '\0'); // No empty strings!
+
+                    lengths[i] = str ? stringLength(str) : 0;
+                    hashes[i] = HashedString(str, lengths[i]).getHash();
+                    prefetchSlots(hashes[i]);
+                }
+                for (size_t i = 0; i < batch; i++) {
+                    PooledString& result = results[first + i];
+                    result = lengths[i] == 0 ? PooledString{nullptr} :
+                            intern(strings[first + i], lengths[i], hashes[i]);
+                    if (result)
+                        pooled++;
+                }
+            }
+            return pooled;
+        }
+
+        // Interning
+        PooledString StringPool::intern(const char* str, size_t rawSize,
+                HashType hash) {
+            // Look it up in the image, then the index
+            const char* found = findInImage(str, rawSize, hash);
+            if (found)
+                return PooledString{const_cast<char*>(found)};
+            IndexSlot* slot = findSlot(str, rawSize, hash);
+            if (slot && slot->hash != HashedString::EMPTY_STRING_HASH) {
+                // Our index found it!  Return it as a PooledString
+                return PooledString{const_cast<char*>(slot->string)};
             } else {
                 // We didn't find it..  we'll have to add it..
-                size_t rawSize = strlen(str);
                 assert(rawSize <= UINT16_MAX); // REMEMBER THE LIMITS!!
                 uint16_t size = static_cast<uint16_t>(rawSize);
 
-                // Make sure that the store can actually HOLD the string..
-                uintptr_t storeEnd = reinterpret_cast<uintptr_t>(
-                        _store->getRawStorage() + _store->SIZE);
-                uintptr_t strEnd = reinterpret_cast<uintptr_t>(
-                        pointer + size + sizeof(uint16_t) + 1);
-                if (storeEnd >= strEnd && _count < UINT_MAX) {
+                // Keep the index at most three quarters full.  (If it can't
+                // grow it may fill further, but never completely.)
+                if (slot && (size_t(_count) + 1) * 4 > _slotCount * 3 &&
+                        growIndex())
+                    slot = findSlot(str, rawSize, hash);
+                if (slot && size_t(_count) + 2 > _slotCount)
+                    slot = nullptr;
+
+                // Make sure that a store can actually HOLD the string..
+                size_t entrySize = PooledString::getEntrySize(size);
+                Segment* segment = slot && _count < UINT_MAX ?
+                        reserve(entrySize) : nullptr;
+                if (segment) {
                     // there's space for this string
                     _count++;
-                    uint16_t* sizePtr = reinterpret_cast<uint16_t*>(pointer);
-                    *sizePtr = size;
-                    pointer += sizeof(uint16_t);
-                    char* pooledString = reinterpret_cast<char*>(pointer);
-                    strcpy(pooledString, str);
+                    char* pooledString = PooledString::writeEntry(
+                            segment->store->getRawStorage() + segment->used,
+                            str, size, hash);
+
+                    *slot = IndexSlot {pooledString, hash};
+                    segment->used += entrySize;
 
+                    recordAllocation(_tag, entrySize);
                     return PooledString{pooledString};
                 } else {
-                    // Store too small (likely) or max count reached
-                    // Should probably report something in Debug mode...
-                    // In a release build, though, we want to return a nullptr
+                    // Store (or index) too small (likely) or max count
+                    // reached.  Should probably report something in Debug
+                    // mode...  In a release build, though, we want to return
+                    // a nullptr
+                    recordAllocationFailure(_tag,
+                            PooledString::getEntrySize(size));
                     return PooledString{nullptr};
                 }
             }
         }
 
         bool StringPool::contains(const char* str) const {
-            uint8_t* store = _store->getRawStorage();
-            return findString(&store, str, _count);
+            if (str == nullptr || str[0] == '\0')
+                return false;
+
+            size_t length = stringLength(str);
+            return contains(str, length, HashedString(str, length).getHash());
         }
         bool StringPool::contains(const PooledString& str) const {
-            return contains(str.getCharPointer());
+            // (The string already knows its length and hash.)
+            if (!str)
+                return false;
+            return contains(str.getCharPointer(), str.length(),
+                    str.getHash());
+        }
+        bool StringPool::contains(const char* str, size_t length,
+                HashType hash) const {
+            if (findInImage(str, length, hash))
+                return true;
+            IndexSlot* slot = findSlot(str, length, hash);
+            return slot && slot->hash != HashedString::EMPTY_STRING_HASH;
+        }
+
+        // Images
+        StringPool StringPool::openImage(IStore* image, IStore* overflow,
+                IStore* indexStore) {
+            StringPool pool {overflow, indexStore};
+            pool.attachImage(image);
+            return pool;
+        }
+        bool StringPool::hasImage() const {
+            return _image != nullptr;
+        }
+
+        // Only the header is checked; the entries and index are trusted
+        // (checking them would mean touching the whole image).
+        void StringPool::attachImage(IStore* store) {
+            if (store == nullptr)
+                return;
+
+            const uint8_t* image = store->getRawStorage();
+            const ImageHeader* header =
+                    reinterpret_cast<const ImageHeader*>(image);
+            uint64_t size = store->SIZE;
+            bool valid = image && size >= sizeof(ImageHeader) &&
+                    libxaos::memory::isAligned(image, alignof(ImageSlot));
+            valid = valid && header->magic == IMAGE_MAGIC &&
+                    header->version == IMAGE_VERSION &&
+                    header->hashSize == sizeof(HashType);
+            valid = valid && header->entriesOffset >= sizeof(ImageHeader) &&
+                    uint64_t(header->entriesOffset) + header->entriesSize <=
+                    header->indexOffset &&
+                    header->indexOffset % alignof(ImageSlot) == 0 &&
+                    uint64_t(header->indexOffset) + uint64_t(
+                    header->slotCount) * sizeof(ImageSlot) <= size;
+            valid = valid && header->slotCount > header->count &&
+                    (header->slotCount & (header->slotCount - 1)) == 0;
+            if (!valid) {
+                delete store;
+                return;
+            }
+
+            _imageStore = store;
+            _image = header;
+        }
+        const char* StringPool::findInImage(const char* str, size_t length,
+                HashType hash) const {
+            if (_image == nullptr)
+                return nullptr;
+
+            const char* image = reinterpret_cast<const char*>(_image);
+            const ImageSlot* slots = reinterpret_cast<const ImageSlot*>(
+                    image + _image->indexOffset);
+            size_t mask = _image->slotCount - 1;
+            for (size_t index = hash & mask; ; index = (index + 1) & mask) {
+                const ImageSlot& slot = slots[index];
+                if (slot.hash == HashedString::EMPTY_STRING_HASH)
+                    return nullptr;
+                const char* candidate = image + slot.offset;
+                if (slot.hash == hash && PooledString::readHeader(
+                        candidate).length == length &&
+                        stringsEqual(candidate, str, length))
+                    return candidate;
+            }
+        }
+
+        size_t StringPool::getImageSize() const {
+            uint64_t count = _count;
+            uint64_t entriesSize = 0;
+            if (_image) {
+                count += _image->count;
+                entriesSize += _image->entriesSize;
+            }
+            for (size_t i = 0; i < _segmentCount; i++) {
+                entriesSize += _segments[i].used;
+            }
+
+            uint64_t size = sizeof(ImageHeader) + entriesSize;
+            size += (alignof(ImageSlot) - size % alignof(ImageSlot)) %
+                    alignof(ImageSlot);
+            size += uint64_t(getImageSlotCount(count)) * sizeof(ImageSlot);
+            return size <= UINT32_MAX ? static_cast<size_t>(size) : 0;
+        }
+        size_t StringPool::writeImage(void* buffer, size_t bufferSize) const {
+            size_t size = getImageSize();
+            if (size == 0 || size > bufferSize || buffer == nullptr ||
+                    !libxaos::memory::isAligned(buffer, alignof(ImageSlot)))
+                return 0;
+
+            // The entries are copied as they are (they're already laid out
+            // as one run of entries would be).
+            uint8_t* image = static_cast<uint8_t*>(buffer);
+            ImageHeader* header = reinterpret_cast<ImageHeader*>(image);
+            uint32_t offset = sizeof(ImageHeader);
+            if (_image) {
+                memcpy(image + offset, reinterpret_cast<const uint8_t*>(
+                        _image) + _image->entriesOffset, _image->entriesSize);
+                offset += _image->entriesSize;
+            }
+            for (size_t i = 0; i < _segmentCount; i++) {
+                memcpy(image + offset, _segments[i].store->getRawStorage(),
+                        _segments[i].used);
+                offset += static_cast<uint32_t>(_segments[i].used);
+            }
+
+            header->magic = IMAGE_MAGIC;
+            header->version = IMAGE_VERSION;
+            header->hashSize = sizeof(HashType);
+            header->count = _count + (_image ? _image->count : 0);
+            header->entriesOffset = sizeof(ImageHeader);
+            header->entriesSize = offset - header->entriesOffset;
+            header->indexOffset = static_cast<uint32_t>(
+                    libxaos::memory::alignUp(offset, alignof(ImageSlot)));
+            header->slotCount = static_cast<uint32_t>(
+                    getImageSlotCount(header->count));
+            memset(image + offset, 0, size - offset);
+
+            // Index every entry.  (No two are the same string.)
+            ImageSlot* slots = reinterpret_cast<ImageSlot*>(image +
+                    header->indexOffset);
+            uint32_t mask = header->slotCount - 1;
+            for (uint32_t entry = header->entriesOffset; entry < offset;) {
+                PooledString str {reinterpret_cast<char*>(image + entry +
+                        sizeof(PooledString::Header))};
+                uint32_t index = str.getHash() & mask;
+                while (slots[index].hash != HashedString::EMPTY_STRING_HASH) {
+                    index = (index + 1) & mask;
+                }
+                slots[index] = ImageSlot {static_cast<uint32_t>(entry +
+                        sizeof(PooledString::Header)), str.getHash()};
+                entry += static_cast<uint32_t>(
+                        PooledString::getEntrySize(str.length()));
+            }
+            return size;
+        }
+
+        // Chaining
+        void StringPool::setStoreFactory(StoreFactory factory) {
+            _factory = std::move(factory);
+        }
+        const StringPool::StoreFactory& StringPool::getStoreFactory() const {
+            return _factory;
+        }
+        size_t StringPool::getStoreCount() const {
+            return _segmentCount;
+        }
+
+        // Tracking
+        void StringPool::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        MemoryTag StringPool::getMemoryTag() const {
+            return _tag;
         }
     }
 }
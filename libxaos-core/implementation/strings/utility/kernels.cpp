@@ -0,0 +1,374 @@
+/**
+ *  @file kernels.cpp
+ *  @brief Implements: libxaos-core:strings/utility/kernels.h
+ *
+ *  This file provides implementations for the string kernels.
+ *
+ *  djb2 over characters c0..c(n-1) is hash * 33^n + the sum of
+ *  ci * 33^(n-1-i) (all modulo the HashType's width), so a block of n
+ *  characters is a multiply of the running hash plus a dot product that
+ *  doesn't depend on it.  The vector kernels widen each character to 32
+ *  bits and multiply by HASH_WEIGHTS; unsigned wraparound makes the result
+ *  identical to hashing one character at a time.
+ *
+ *  FNV-1a (the wide hash) xors each character in before multiplying, so it
+ *  can't be split up the same way; it's always hashed one character at a
+ *  time.
+ *
+ *  The SSE4.2 and AVX2 kernels are built with target attributes (no -m
+ *  flags needed) and only called once the CPU is known to support them.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "memory/utility/alignment.h"
+#include "strings/HashedString.h"
+#include "strings/utility/kernels.h"
+#include "utility/cpu.h"
+
+#if defined(LIBXAOS_FLAG_CPU_INTEL) && (defined(__SSE2__) || \
+        defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define LIBXAOS_STRING_SSE2
+    #include <immintrin.h>
+    // FNV-1a has no vector kernels.
+    #ifndef LIBXAOS_FLAG_WIDE_HASHES
+        #define LIBXAOS_STRING_VECTOR_HASH
+    #endif
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define LIBXAOS_STRING_TARGET_SSE42
+        #define LIBXAOS_STRING_TARGET_AVX2
+        // Reading past the end of a string is fine within its page.
+        #define LIBXAOS_STRING_OVERREADS
+    #else
+        #define LIBXAOS_STRING_TARGET_SSE42 __attribute__((target("sse4.2")))
+        #define LIBXAOS_STRING_TARGET_AVX2 __attribute__((target("avx2")))
+        #define LIBXAOS_STRING_OVERREADS \
+                __attribute__((no_sanitize_address, no_sanitize_thread))
+    #endif
+#endif
+
+using libxaos::memory::alignDown;
+
+namespace libxaos {
+    namespace strings {
+
+        // Kernels!  Only visible here.
+        namespace {
+            //! 33^n in the HashType's width.
+            constexpr HashType power33(unsigned int n) {
+                return n == 0 ? 1 : static_cast<HashType>(33U *
+                        power33(n - 1));
+            }
+            //! 33^n in 32 bits (for the vector kernels).
+            constexpr uint32_t weight(unsigned int n) {
+                return static_cast<uint32_t>(power33(n));
+            }
+
+            // Plain
+            // djb2 takes eight characters per step, so only one multiply is
+            // waiting on the last.
+            HashType hashRangePlain(const uint8_t* str, size_t length,
+                    HashType hash) {
+                #ifdef LIBXAOS_FLAG_WIDE_HASHES
+                    for (size_t i = 0; i < length; i++) {
+                        hash = (hash ^ str[i]) *
+                                HashedString::HASH_MULTIPLIER;
+                    }
+                #else
+                    size_t body = alignDown(length, 8);
+                    for (size_t i = 0; i < body; i += 8) {
+                        const uint8_t* c = str + i;
+                        hash = static_cast<HashType>(hash * power33(8) +
+                                c[0] * power33(7) + c[1] * power33(6) +
+                                c[2] * power33(5) + c[3] * power33(4) +
+                                c[4] * power33(3) + c[5] * power33(2) +
+                                c[6] * power33(1) + c[7]);
+                    }
+                    for (size_t i = body; i < length; i++) {
+                        hash = static_cast<HashType>(hash * 33U + str[i]);
+                    }
+                #endif
+                return hash;
+            }
+
+            #ifdef LIBXAOS_STRING_SSE2
+                //! Returns the index of the lowest set bit.  (Never zero!)
+                inline unsigned int lowestBit(uint32_t mask) {
+                    #ifdef _MSC_VER
+                        unsigned long index;
+                        _BitScanForward(&index, mask);
+                        return static_cast<unsigned int>(index);
+                    #else
+                        return static_cast<unsigned int>(
+                                __builtin_ctz(mask));
+                    #endif
+                }
+
+                #ifdef LIBXAOS_STRING_VECTOR_HASH
+                    //! The weight of each character in a 32 character block
+                    //! (33^31 down to 33^0).  The last 16 serve 16 character
+                    //! blocks.
+                    alignas(32) const uint32_t HASH_WEIGHTS[32] = {
+                        weight(31), weight(30), weight(29), weight(28),
+                        weight(27), weight(26), weight(25), weight(24),
+                        weight(23), weight(22), weight(21), weight(20),
+                        weight(19), weight(18), weight(17), weight(16),
+                        weight(15), weight(14), weight(13), weight(12),
+                        weight(11), weight(10), weight(9), weight(8),
+                        weight(7), weight(6), weight(5), weight(4),
+                        weight(3), weight(2), weight(1), weight(0)
+                    };
+                #endif
+
+                // SSE2 / SSE4.2
+                // Aligned loads never cross into the next page.
+                LIBXAOS_STRING_OVERREADS
+                size_t stringLengthSSE2(const char* str) {
+                    const char* block = alignDown(str, 16);
+                    __m128i zero = _mm_setzero_si128();
+                    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                            _mm_cmpeq_epi8(_mm_load_si128(
+                            reinterpret_cast<const __m128i*>(block)), zero)));
+                    mask >>= str - block;
+                    if (mask != 0)
+                        return lowestBit(mask);
+
+                    for (block += 16; ; block += 16) {
+                        mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                                _mm_cmpeq_epi8(_mm_load_si128(
+                                reinterpret_cast<const __m128i*>(block)),
+                                zero)));
+                        if (mask != 0)
+                            return static_cast<size_t>(block - str) +
+                                    lowestBit(mask);
+                    }
+                }
+                // The last block overlaps the one before it rather than
+                // falling back to a byte loop.
+                bool stringsEqualSSE2(const uint8_t* a, const uint8_t* b,
+                        size_t length) {
+                    if (length < 16)
+                        return memcmp(a, b, length) == 0;
+
+                    for (size_t i = 0; ; i += 16) {
+                        if (i > length - 16)
+                            i = length - 16;
+                        const __m128i* left =
+                                reinterpret_cast<const __m128i*>(a + i);
+                        const __m128i* right =
+                                reinterpret_cast<const __m128i*>(b + i);
+                        __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(left),
+                                _mm_loadu_si128(right));
+                        if (_mm_movemask_epi8(equal) != 0xFFFF)
+                            return false;
+                        if (i == length - 16)
+                            return true;
+                    }
+                }
+                #ifdef LIBXAOS_STRING_VECTOR_HASH
+                    LIBXAOS_STRING_TARGET_SSE42
+                    HashType hashRangeSSE42(const uint8_t* str, size_t length,
+                            HashType hash) {
+                        const __m128i* weights =
+                                reinterpret_cast<const __m128i*>(
+                                HASH_WEIGHTS + 16);
+                        __m128i w0 = _mm_load_si128(weights);
+                        __m128i w1 = _mm_load_si128(weights + 1);
+                        __m128i w2 = _mm_load_si128(weights + 2);
+                        __m128i w3 = _mm_load_si128(weights + 3);
+
+                        size_t body = alignDown(length, 16);
+                        for (size_t i = 0; i < body; i += 16) {
+                            __m128i c = _mm_loadu_si128(
+                                    reinterpret_cast<const __m128i*>(str + i));
+                            __m128i a = _mm_mullo_epi32(_mm_cvtepu8_epi32(c),
+                                    w0);
+                            __m128i b = _mm_mullo_epi32(_mm_cvtepu8_epi32(
+                                    _mm_srli_si128(c, 4)), w1);
+                            __m128i d = _mm_mullo_epi32(_mm_cvtepu8_epi32(
+                                    _mm_srli_si128(c, 8)), w2);
+                            __m128i e = _mm_mullo_epi32(_mm_cvtepu8_epi32(
+                                    _mm_srli_si128(c, 12)), w3);
+
+                            __m128i sum = _mm_add_epi32(_mm_add_epi32(a, b),
+                                    _mm_add_epi32(d, e));
+                            sum = _mm_add_epi32(sum,
+                                    _mm_shuffle_epi32(sum, 0x4E));
+                            sum = _mm_add_epi32(sum,
+                                    _mm_shuffle_epi32(sum, 0xB1));
+                            hash = static_cast<HashType>(hash * power33(16) +
+                                    static_cast<uint32_t>(
+                                    _mm_cvtsi128_si32(sum)));
+                        }
+                        return hashRangePlain(str + body, length - body, hash);
+                    }
+                #endif
+
+                // AVX2
+                LIBXAOS_STRING_OVERREADS LIBXAOS_STRING_TARGET_AVX2
+                size_t stringLengthAVX2(const char* str) {
+                    const char* block = alignDown(str, 32);
+                    __m256i zero = _mm256_setzero_si256();
+                    uint32_t mask = static_cast<uint32_t>(
+                            _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_load_si256(reinterpret_cast<const __m256i*>(
+                            block)), zero)));
+                    mask >>= str - block;
+                    if (mask != 0)
+                        return lowestBit(mask);
+
+                    for (block += 32; ; block += 32) {
+                        mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                                _mm256_cmpeq_epi8(_mm256_load_si256(
+                                reinterpret_cast<const __m256i*>(block)),
+                                zero)));
+                        if (mask != 0)
+                            return static_cast<size_t>(block - str) +
+                                    lowestBit(mask);
+                    }
+                }
+                LIBXAOS_STRING_TARGET_AVX2
+                bool stringsEqualAVX2(const uint8_t* a, const uint8_t* b,
+                        size_t length) {
+                    if (length < 32)
+                        return stringsEqualSSE2(a, b, length);
+
+                    for (size_t i = 0; ; i += 32) {
+                        if (i > length - 32)
+                            i = length - 32;
+                        const __m256i* left =
+                                reinterpret_cast<const __m256i*>(a + i);
+                        const __m256i* right =
+                                reinterpret_cast<const __m256i*>(b + i);
+                        __m256i equal = _mm256_cmpeq_epi8(
+                                _mm256_loadu_si256(left),
+                                _mm256_loadu_si256(right));
+                        if (static_cast<uint32_t>(_mm256_movemask_epi8(equal))
+                                != UINT32_MAX)
+                            return false;
+                        if (i == length - 32)
+                            return true;
+                    }
+                }
+                #ifdef LIBXAOS_STRING_VECTOR_HASH
+                    LIBXAOS_STRING_TARGET_AVX2
+                    HashType hashRangeAVX2(const uint8_t* str, size_t length,
+                            HashType hash) {
+                        const __m256i* weights =
+                                reinterpret_cast<const __m256i*>(HASH_WEIGHTS);
+                        __m256i w0 = _mm256_load_si256(weights);
+                        __m256i w1 = _mm256_load_si256(weights + 1);
+                        __m256i w2 = _mm256_load_si256(weights + 2);
+                        __m256i w3 = _mm256_load_si256(weights + 3);
+
+                        size_t body = alignDown(length, 32);
+                        for (size_t i = 0; i < body; i += 32) {
+                            __m128i low = _mm_loadu_si128(
+                                    reinterpret_cast<const __m128i*>(str + i));
+                            __m128i high = _mm_loadu_si128(
+                                    reinterpret_cast<const __m128i*>(
+                                str + i + 16));
+                            __m256i a = _mm256_mullo_epi32(
+                                    _mm256_cvtepu8_epi32(low), w0);
+                            __m256i b = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(
+                                    _mm_srli_si128(low, 8)), w1);
+                            __m256i d = _mm256_mullo_epi32(
+                                    _mm256_cvtepu8_epi32(high), w2);
+                            __m256i e = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(
+                                    _mm_srli_si128(high, 8)), w3);
+
+                            __m256i sum = _mm256_add_epi32(
+                                    _mm256_add_epi32(a, b),
+                                    _mm256_add_epi32(d, e));
+                            __m128i half = _mm_add_epi32(
+                                    _mm256_castsi256_si128(sum),
+                                    _mm256_extracti128_si256(sum, 1));
+                            half = _mm_add_epi32(half,
+                                    _mm_shuffle_epi32(half, 0x4E));
+                            half = _mm_add_epi32(half,
+                                    _mm_shuffle_epi32(half, 0xB1));
+                            hash = static_cast<HashType>(hash * power33(32) +
+                                    static_cast<uint32_t>(
+                                    _mm_cvtsi128_si32(half)));
+                        }
+                        _mm256_zeroupper();
+                        return hashRangeSSE42(str + body, length - body, hash);
+                    }
+                #endif
+
+                // Feature Detection
+                StringKernel detectStringKernel() {
+                    #ifdef _MSC_VER
+                        // CPUID.1:ECX has SSE4.2 (20), OSXSAVE (27) and AVX
+                        // (28); CPUID.7:EBX has AVX2 (5).  XCR0 must show
+                        // the OS saves the XMM and YMM state.
+                        int info[4];
+                        __cpuid(info, 1);
+                        if ((info[2] & (1 << 20)) == 0)
+                            return STRING_KERNEL_PLAIN;
+                        if ((info[2] & (1 << 27)) == 0 ||
+                                (info[2] & (1 << 28)) == 0 ||
+                                (_xgetbv(0) & 0x6) != 0x6)
+                            return STRING_KERNEL_SSE42;
+                        __cpuidex(info, 7, 0);
+                        return (info[1] & (1 << 5)) ? STRING_KERNEL_AVX2 :
+                                STRING_KERNEL_SSE42;
+                    #else
+                        __builtin_cpu_init();
+                        if (__builtin_cpu_supports("avx2"))
+                            return STRING_KERNEL_AVX2;
+                        if (__builtin_cpu_supports("sse4.2"))
+                            return STRING_KERNEL_SSE42;
+                        return STRING_KERNEL_PLAIN;
+                    #endif
+                }
+            #endif
+        }
+
+        StringKernel getStringKernel() {
+            #ifdef LIBXAOS_STRING_SSE2
+                static const StringKernel kernel = detectStringKernel();
+                return kernel;
+            #else
+                return STRING_KERNEL_PLAIN;
+            #endif
+        }
+
+        size_t stringLength(const char* str) {
+            #ifdef LIBXAOS_STRING_SSE2
+                if (getStringKernel() == STRING_KERNEL_AVX2)
+                    return stringLengthAVX2(str);
+                return stringLengthSSE2(str); // Always there
+            #else
+                return strlen(str);
+            #endif
+        }
+        bool stringsEqual(const char* a, const char* b, size_t length) {
+            const uint8_t* left = reinterpret_cast<const uint8_t*>(a);
+            const uint8_t* right = reinterpret_cast<const uint8_t*>(b);
+
+            #ifdef LIBXAOS_STRING_SSE2
+                if (getStringKernel() == STRING_KERNEL_AVX2)
+                    return stringsEqualAVX2(left, right, length);
+                return stringsEqualSSE2(left, right, length);
+            #else
+                return memcmp(left, right, length) == 0;
+            #endif
+        }
+        HashType hashRange(const char* str, size_t length, HashType hash) {
+            const uint8_t* characters = reinterpret_cast<const uint8_t*>(str);
+
+            #ifdef LIBXAOS_STRING_VECTOR_HASH
+                StringKernel kernel = getStringKernel();
+                if (kernel == STRING_KERNEL_AVX2)
+                    return hashRangeAVX2(characters, length, hash);
+                if (kernel == STRING_KERNEL_SSE42)
+                    return hashRangeSSE42(characters, length, hash);
+            #endif
+            return hashRangePlain(characters, length, hash);
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ *  @file registry.cpp
+ *  @brief Implements: libxaos-core:strings/utility/registry.h
+ *
+ *  This file provides implementations for the HashedString registry.  The
+ *  registry is created on first use and never destroyed, so strings may be
+ *  hashed before main() and during static destruction.
+ */
+
+#include <cstddef>
+
+#ifdef LIBXAOS_FLAG_HASH_REGISTRY
+    #include <mutex>
+    #include <string>
+    #include <unordered_map>
+#endif
+
+#include "strings/HashedString.h"
+#include "strings/utility/registry.h"
+
+namespace libxaos {
+    namespace strings {
+
+        #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+            // Helpers!  Only visible here.
+            namespace {
+                //! Everything the registry holds.
+                struct Registry {
+                    Registry() : mutex(), strings(), collisionCount(0),
+                            handler(nullptr) {}
+
+                    //! Held for every access.
+                    std::mutex mutex;
+                    //! The first string recorded for each hash.
+                    std::unordered_map<HashType, std::string> strings;
+                    //! The number of collisions found.
+                    size_t collisionCount;
+                    //! Called on each collision.
+                    HashCollisionHandler handler;
+                };
+
+                Registry& getRegistry() {
+                    static Registry* registry = new Registry();
+                    return *registry;
+                }
+            }
+
+            // Recording
+            bool recordHashedString(HashType hash, const char* str,
+                    size_t length) {
+                if (str == nullptr || length == 0)
+                    return true;
+
+                Registry& registry = getRegistry();
+                std::lock_guard<std::mutex> lock {registry.mutex};
+                auto found = registry.strings.find(hash);
+                if (found == registry.strings.end()) {
+                    registry.strings.emplace(hash, std::string(str, length));
+                    return true;
+                }
+                if (found->second.compare(0, std::string::npos, str,
+                        length) == 0)
+                    return true;
+
+                registry.collisionCount++;
+                if (registry.handler) {
+                    std::string colliding {str, length};
+                    registry.handler(hash, found->second.c_str(),
+                            colliding.c_str());
+                }
+                return false;
+            }
+        #endif
+
+        // Queries
+        void setHashCollisionHandler(HashCollisionHandler handler) {
+            #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+                Registry& registry = getRegistry();
+                std::lock_guard<std::mutex> lock {registry.mutex};
+                registry.handler = handler;
+            #else
+                (void) handler;
+            #endif
+        }
+        const char* lookupHashedString(HashType hash) {
+            #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+                Registry& registry = getRegistry();
+                std::lock_guard<std::mutex> lock {registry.mutex};
+                auto found = registry.strings.find(hash);
+                return found == registry.strings.end() ? nullptr :
+                        found->second.c_str();
+            #else
+                (void) hash;
+                return nullptr;
+            #endif
+        }
+        size_t getHashedStringCount() {
+            #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+                Registry& registry = getRegistry();
+                std::lock_guard<std::mutex> lock {registry.mutex};
+                return registry.strings.size();
+            #else
+                return 0;
+            #endif
+        }
+        size_t getHashCollisionCount() {
+            #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+                Registry& registry = getRegistry();
+                std::lock_guard<std::mutex> lock {registry.mutex};
+                return registry.collisionCount;
+            #else
+                return 0;
+            #endif
+        }
+    }
+}
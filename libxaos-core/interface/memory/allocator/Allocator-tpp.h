@@ -0,0 +1,54 @@
+/**
+ *  @file Allocator-tpp.h
+ *  @brief Template Implementations for Allocator.h
+ */
+
+#include <new>
+
+namespace libxaos {
+    namespace memory {
+
+        // Constructors
+        template<typename T, typename A>
+        Allocator<T, A>::Allocator(A& allocator) : _allocator(&allocator) {}
+        template<typename T, typename A>
+        template<typename U>
+        Allocator<T, A>::Allocator(const Allocator<U, A>& other) :
+                _allocator(other.getAllocator()) {}
+
+        // Allocation
+        template<typename T, typename A>
+        T* Allocator<T, A>::allocate(size_t count) {
+            if (count > static_cast<size_t>(-1) / sizeof(T))
+                throw std::bad_alloc();
+
+            void* pointer = _allocator->allocate(count * sizeof(T),
+                    alignof(T));
+            if (pointer == nullptr)
+                throw std::bad_alloc();
+            return static_cast<T*>(pointer);
+        }
+        template<typename T, typename A>
+        void Allocator<T, A>::deallocate(T* pointer, size_t) {
+            _allocator->deallocate(pointer);
+        }
+
+        // Queries
+        template<typename T, typename A>
+        A* Allocator<T, A>::getAllocator() const {
+            return _allocator;
+        }
+
+        // Comparison
+        template<typename T, typename U, typename A>
+        bool operator==(const Allocator<T, A>& lhs,
+                const Allocator<U, A>& rhs) {
+            return lhs.getAllocator() == rhs.getAllocator();
+        }
+        template<typename T, typename U, typename A>
+        bool operator!=(const Allocator<T, A>& lhs,
+                const Allocator<U, A>& rhs) {
+            return !(lhs == rhs);
+        }
+    }
+}
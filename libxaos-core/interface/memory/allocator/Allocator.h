@@ -1 +1,73 @@
+#ifndef     LIBXAOS_CORE_MEMORY_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_ALLOCATOR_H
 
+#include <cstddef>
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief An Allocator adapts a libxaos allocator for standard
+         *  containers.
+         *
+         *  An Allocator is a classic (C++11) STL allocator that forwards to a
+         *  libxaos allocator it does NOT own.  Any allocator providing the
+         *  following may be used:
+         *  - void* allocate(size_t size, size_t alignment)
+         *  - void deallocate(void*)
+         *
+         *  LinearAllocator, StackAllocator, DoubleBufferedAllocator,
+         *  PoolAllocator, BuddyAllocator, TLSFAllocator and
+         *  ThreadCachingAllocator do.  ObjectPool (which constructs objects)
+         *  and RelocatableHeap (which hands out Handles) don't.  (Stores are
+         *  used through an allocator, typically a LinearAllocator.)
+         *
+         *  As standard containers expect, allocate() throws std::bad_alloc
+         *  rather than returning a nullptr.  Allocators compare equal if they
+         *  forward to the same libxaos allocator.
+         *
+         *  @tparam T the type being allocated.
+         *  @tparam A the libxaos allocator to forward to.
+         */
+        template<typename T, typename A>
+        class Allocator {
+
+            public:
+                using value_type = T;
+
+                //! Containers rebind to their node types.
+                template<typename U>
+                struct rebind {
+                    using other = Allocator<U, A>;
+                };
+
+                //! Forwards to the provided allocator.
+                Allocator(A&);
+                //! Converts from another type's Allocator.
+                template<typename U>
+                Allocator(const Allocator<U, A>&);
+
+                //! Allocates room for n T.
+                T* allocate(size_t);
+                //! Returns room for n T.
+                void deallocate(T*, size_t);
+
+                //! Returns the allocator this forwards to.
+                A* getAllocator() const;
+
+            private:
+                A* _allocator;
+        };
+
+        template<typename T, typename U, typename A>
+        bool operator==(const Allocator<T, A>&, const Allocator<U, A>&);
+        template<typename T, typename U, typename A>
+        bool operator!=(const Allocator<T, A>&, const Allocator<U, A>&);
+
+    }
+}
+
+// Bring in template definitions.
+#include "Allocator-tpp.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_ALLOCATOR_H
@@ -0,0 +1,40 @@
+/**
+ *  @file MemoryResource-tpp.h
+ *  @brief Template Implementations for MemoryResource.h
+ */
+
+#include <new>
+
+namespace libxaos {
+    namespace memory {
+
+        // Constructors
+        template<typename A>
+        MemoryResource<A>::MemoryResource(A& allocator) :
+                _allocator(allocator) {}
+
+        // Queries
+        template<typename A>
+        A& MemoryResource<A>::getAllocator() const {
+            return _allocator;
+        }
+
+        // memory_resource
+        template<typename A>
+        void* MemoryResource<A>::do_allocate(size_t size, size_t alignment) {
+            void* pointer = _allocator.allocate(size, alignment);
+            if (pointer == nullptr)
+                throw std::bad_alloc();
+            return pointer;
+        }
+        template<typename A>
+        void MemoryResource<A>::do_deallocate(void* pointer, size_t, size_t) {
+            _allocator.deallocate(pointer);
+        }
+        template<typename A>
+        bool MemoryResource<A>::do_is_equal(
+                const std::pmr::memory_resource& other) const noexcept {
+            return this == &other;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef     LIBXAOS_CORE_MEMORY_MEMORY_RESOURCE_H
+#define     LIBXAOS_CORE_MEMORY_MEMORY_RESOURCE_H
+
+// std::pmr only exists from C++17 on.  (libxaos itself is C++11.)
+#if __cplusplus >= 201703L
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A MemoryResource exposes a libxaos allocator as a
+         *  std::pmr::memory_resource.
+         *
+         *  A MemoryResource forwards to a libxaos allocator it does NOT own,
+         *  so any std::pmr container may allocate from it.  The allocator
+         *  must provide the same methods Allocator requires:
+         *  - void* allocate(size_t size, size_t alignment)
+         *  - void deallocate(void*)
+         *
+         *  Failed allocations throw std::bad_alloc.  Two MemoryResources are
+         *  equal only if they are the same object.
+         *
+         *  This header is empty unless compiled as C++17 (or later).
+         *
+         *  @tparam A the libxaos allocator to forward to.
+         */
+        template<typename A>
+        class MemoryResource : public std::pmr::memory_resource {
+
+            public:
+                //! Forwards to the provided allocator.
+                MemoryResource(A&);
+
+                //! Returns the allocator this forwards to.
+                A& getAllocator() const;
+
+            private:
+                void* do_allocate(size_t, size_t) override;
+                void do_deallocate(void*, size_t, size_t) override;
+                bool do_is_equal(const std::pmr::memory_resource&)
+                        const noexcept override;
+
+                A& _allocator;
+        };
+
+    }
+}
+
+// Bring in template definitions.
+#include "MemoryResource-tpp.h"
+
+#endif   // __cplusplus >= 201703L
+
+#endif   // LIBXAOS_CORE_MEMORY_MEMORY_RESOURCE_H
@@ -0,0 +1,43 @@
+/**
+ *  @file NumaPools-tpp.h
+ *  @brief Template Implementations for NumaPools.h
+ */
+
+#include <cassert>
+
+namespace libxaos {
+    namespace memory {
+
+        // Constructors
+        template<typename A>
+        template<typename F>
+        NumaPools<A>::NumaPools(F factory) : _pools(),
+                _nodeCount(getNumaNodeCount()) {
+            for (size_t node = 0; node < _nodeCount; node++) {
+                _pools[node] = factory(node);
+                assert(_pools[node]); // Every node needs an allocator!
+            }
+        }
+        template<typename A>
+        NumaPools<A>::~NumaPools() {
+            for (size_t node = 0; node < _nodeCount; node++) {
+                delete _pools[node];
+            }
+        }
+
+        // Queries
+        template<typename A>
+        A& NumaPools<A>::getLocal() const {
+            return *_pools[getCurrentNumaNode()];
+        }
+        template<typename A>
+        A& NumaPools<A>::get(size_t node) const {
+            assert(node < _nodeCount);
+            return *_pools[node];
+        }
+        template<typename A>
+        size_t NumaPools<A>::getNodeCount() const {
+            return _nodeCount;
+        }
+    }
+}
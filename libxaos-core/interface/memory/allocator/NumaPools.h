@@ -0,0 +1,75 @@
+#ifndef     LIBXAOS_CORE_MEMORY_NUMA_POOLS_H
+#define     LIBXAOS_CORE_MEMORY_NUMA_POOLS_H
+
+#include <cstddef>
+
+#include "memory/utility/numa.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief NumaPools keeps one allocator per NUMA node and hands each
+         *  thread the one for the node it's running on.
+         *
+         *  The allocators are made by a factory (anything callable as
+         *  A*(size_t node)) when the NumaPools is constructed, typically by
+         *  building an allocator over a NumaStore for that node:
+         *
+         *      NumaPools<TLSFAllocator> pools {[](size_t node) {
+         *          return new TLSFAllocator(new NumaStore(SIZE, node));
+         *      }};
+         *      void* data = pools.getLocal().allocate(64);
+         *
+         *  On a single node machine there's exactly one allocator and
+         *  getLocal() always returns it.
+         *
+         *  Memory must be returned to the allocator it came from, which isn't
+         *  necessarily the local one (threads migrate).  Use get() with the
+         *  node it was allocated on, or owns() if the allocator has it.
+         *
+         *  NumaPools itself is safe to share between threads once built, but
+         *  the allocators are only as thread safe as A is.
+         *
+         *  @tparam A the allocator kept for each node.
+         */
+        template<typename A>
+        class NumaPools {
+
+            public:
+                //! Builds an allocator for every node with the provided
+                //! factory.  (Acquires ownership of the allocators.)
+                template<typename F>
+                explicit NumaPools(F);
+                ~NumaPools();
+
+                //! No copying!  The allocators are owned.
+                NumaPools(const NumaPools&) = delete;
+                NumaPools& operator=(const NumaPools&) = delete;
+
+                //! No moving either.  (Threads may hold references.)
+                NumaPools(NumaPools&&) = delete;
+                NumaPools& operator=(NumaPools&&) = delete;
+
+                //! Returns the allocator for the calling thread's node.
+                A& getLocal() const;
+                //! Returns the allocator for the provided node.
+                A& get(size_t) const;
+                //! Returns the number of allocators (one per node).
+                size_t getNodeCount() const;
+
+            private:
+                //! The allocator for each node.
+                //! @todo Replace with UniquePointer (when implemented)
+                A* _pools[MAX_NUMA_NODES];
+                //! The number of nodes.
+                size_t _nodeCount;
+        };
+
+    }
+}
+
+// Bring in template definitions.
+#include "NumaPools-tpp.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_NUMA_POOLS_H
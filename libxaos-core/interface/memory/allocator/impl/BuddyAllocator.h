@@ -0,0 +1,158 @@
+#ifndef     LIBXAOS_CORE_MEMORY_BUDDY_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_BUDDY_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A BuddyAllocator hands out power of two sized blocks.
+         *
+         *  A BuddyAllocator manages the raw storage of an IStore as a binary
+         *  tree of blocks.  Each block's size is the minimum block size times
+         *  a power of two (its "order").  Allocation rounds the request up to
+         *  the next order and splits a larger free block in half as many
+         *  times as needed.  Freeing a block merges it with its "buddy" (the
+         *  other half of its parent) for as long as that buddy is also free.
+         *  Both are O(log n) in the number of orders.
+         *
+         *  Free blocks are threaded onto one list per order and tracked in
+         *  two bitmaps (which blocks are free and which are split) so buddies
+         *  can be checked without touching their memory.  The bitmaps live at
+         *  the end of the store; blocks begin at its start (aligned up to the
+         *  smaller of the minimum block size and std::max_align_t), so every
+         *  block is aligned to its own size (up to the first block's
+         *  alignment).
+         *
+         *  Stores that aren't a power of two in size are carved into the
+         *  largest blocks that fit.  The whole store is committed up front.
+         *
+         *  This class is NOT thread safe.
+         */
+        class BuddyAllocator {
+
+            public:
+                //! The smallest block handed out when one isn't specified.
+                static constexpr const size_t DEFAULT_MIN_BLOCK_SIZE = 256;
+                //! The largest number of orders an allocator can have.
+                static constexpr const size_t MAX_ORDER_COUNT =
+                        sizeof(uint64_t) * 8;
+
+                //! A snapshot of the allocator's usage.
+                struct Statistics {
+                    //! Bytes currently handed out (whole blocks).
+                    size_t usedBytes;
+                    //! Bytes currently available (in all free blocks).
+                    size_t freeBytes;
+                    //! The largest single allocation that could succeed.
+                    size_t largestFreeBlock;
+                    //! The number of live allocations.
+                    size_t allocationCount;
+                    //! The number of free blocks.
+                    size_t freeBlockCount;
+                    //! 1 - (largestFreeBlock / freeBytes).  Zero means all
+                    //! free memory is in a single block.
+                    double fragmentation;
+                };
+
+                //! An IStore is required to allocate from, and optionally the
+                //! smallest block to hand out (a power of two).  (Acquires
+                //! ownership of the IStore.)
+                BuddyAllocator(IStore*, size_t = DEFAULT_MIN_BLOCK_SIZE);
+                ~BuddyAllocator();
+
+                //! No copying!  Two allocators can't own the same store.
+                BuddyAllocator(const BuddyAllocator&) = delete;
+                BuddyAllocator& operator=(const BuddyAllocator&) = delete;
+
+                //! No moving either.  Free lists point into this object.
+                BuddyAllocator(BuddyAllocator&&) = delete;
+                BuddyAllocator& operator=(BuddyAllocator&&) = delete;
+
+                //! Allocates a block of (at least) the provided size and
+                //! alignment.  Returns nullptr if no block is large enough.
+                void* allocate(size_t, size_t = alignof(std::max_align_t));
+                //! Returns a block to the allocator.  (nullptr is ignored.)
+                void deallocate(void*);
+
+                //! Returns true if the provided pointer is inside this
+                //! allocator's blocks.
+                bool owns(const void*) const;
+                //! Returns the size of an allocated block.
+                size_t getAllocationSize(const void*) const;
+
+                //! Returns the size of the smallest block.
+                size_t getMinBlockSize() const;
+                //! Returns the number of orders.  (The largest block is
+                //! getMinBlockSize() << (getOrderCount() - 1).)
+                size_t getOrderCount() const;
+                //! Returns the number of free blocks of the provided order.
+                size_t getFreeBlockCount(size_t) const;
+
+                //! Gathers usage statistics.
+                Statistics getStatistics() const;
+
+                //! Sets the tag allocations are recorded under.
+                void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                MemoryTag getMemoryTag() const;
+
+            private:
+                //! Overlays a free block.
+                struct FreeBlock {
+                    FreeBlock* previous;
+                    FreeBlock* next;
+                };
+
+                // Free list management
+                void pushFree(size_t, size_t);
+                void removeFree(FreeBlock*, size_t, size_t);
+                // Tree queries
+                size_t getOrder(size_t) const;
+                bool testBit(const uint64_t*, size_t, size_t) const;
+                void setBit(uint64_t*, size_t, size_t, bool);
+
+                //! The store we allocate from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! The first block.
+                uint8_t* _begin;
+                //! The alignment of the first block (the most any block is
+                //! guaranteed to have).
+                size_t _alignment;
+                //! The number of bytes covered by blocks.
+                size_t _capacity;
+                //! The size of the smallest block (and its log2).
+                size_t _minBlockSize;
+                size_t _minBlockShift;
+                //! The number of orders.
+                size_t _orderCount;
+                //! Which blocks are free (one bit per block of every order).
+                uint64_t* _freeBits;
+                //! Which blocks are split (one bit per block of every order).
+                uint64_t* _splitBits;
+                //! Where each order begins in the bitmaps.
+                size_t _bitOffsets[MAX_ORDER_COUNT];
+                //! The heads of the free lists.
+                FreeBlock* _freeLists[MAX_ORDER_COUNT];
+                //! The number of blocks in each free list.
+                size_t _freeCounts[MAX_ORDER_COUNT];
+                //! Which free lists have blocks.
+                uint64_t _nonEmpty;
+                //! Bytes currently handed out.
+                size_t _usedBytes;
+                //! Number of live allocations.
+                size_t _allocationCount;
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_BUDDY_ALLOCATOR_H
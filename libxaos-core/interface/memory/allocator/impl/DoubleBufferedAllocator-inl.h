@@ -0,0 +1,51 @@
+/**
+ *  @file DoubleBufferedAllocator-inl.h
+ *  @brief Inline implements: libxaos-core:memory/allocator/impl/DoubleBufferedAllocator.h
+ *
+ *  This file provides inline implementations for the DoubleBufferedAllocator
+ *  class.
+ */
+
+namespace libxaos {
+    namespace memory {
+
+        // Allocation
+        inline void* DoubleBufferedAllocator::allocate(size_t size,
+                size_t alignment) {
+            return _buffers[_current].allocate(size, alignment);
+        }
+        inline void DoubleBufferedAllocator::deallocate(void*) {}
+
+        // Frames
+        inline void DoubleBufferedAllocator::tick() {
+            _current ^= 1;
+            _buffers[_current].reset();
+            _frame++;
+        }
+
+        // Buffers
+        inline LinearAllocator& DoubleBufferedAllocator::getCurrentBuffer() {
+            return _buffers[_current];
+        }
+        inline LinearAllocator& DoubleBufferedAllocator::getPreviousBuffer() {
+            return _buffers[_current ^ 1];
+        }
+
+        // Queries
+        inline bool DoubleBufferedAllocator::owns(const void* pointer) const {
+            return _buffers[0].owns(pointer) || _buffers[1].owns(pointer);
+        }
+        inline size_t DoubleBufferedAllocator::getFrame() const {
+            return _frame;
+        }
+
+        // Tracking
+        inline void DoubleBufferedAllocator::setMemoryTag(MemoryTag tag) {
+            _buffers[0].setMemoryTag(tag);
+            _buffers[1].setMemoryTag(tag);
+        }
+        inline MemoryTag DoubleBufferedAllocator::getMemoryTag() const {
+            return _buffers[0].getMemoryTag();
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef     LIBXAOS_CORE_MEMORY_DOUBLE_BUFFERED_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_DOUBLE_BUFFERED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/allocator/Allocator.h"
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A DoubleBufferedAllocator hands out memory that lives for
+         *  exactly two frames.
+         *
+         *  A DoubleBufferedAllocator owns two LinearAllocators.  Allocations
+         *  come from the "current" one.  Calling tick() swaps the two and
+         *  resets the new current one, so memory allocated during frame N is
+         *  still valid throughout frame N + 1 and is freed (in O(1)) by the
+         *  tick that begins frame N + 2.
+         *
+         *  This suits data produced one frame and consumed the next (render
+         *  lists, deferred events, etc.).  Call tick() once per frame, right
+         *  alongside Stopwatch::tick():
+         *
+         *      while (running) {
+         *          stopwatch.tick();
+         *          frameAllocator.tick();
+         *          ...
+         *      }
+         *
+         *  ContainerAllocator adapts it for standard containers.  As with a
+         *  LinearAllocator, NO destructors are run when memory is freed.
+         */
+        class DoubleBufferedAllocator {
+
+            public:
+                //! The alignment used when one isn't specified.
+                static constexpr const size_t DEFAULT_ALIGNMENT =
+                        LinearAllocator::DEFAULT_ALIGNMENT;
+
+                //! An allocator for standard containers whose memory lives
+                //! for two frames.  (deallocate() does nothing.)
+                template<typename T>
+                using ContainerAllocator =
+                        Allocator<T, DoubleBufferedAllocator>;
+
+                //! An IStore is required for each buffer.  (Acquires
+                //! ownership of both IStores.)
+                DoubleBufferedAllocator(IStore*, IStore*);
+                ~DoubleBufferedAllocator();
+
+                //! No copying!  Two allocators can't own the same stores.
+                DoubleBufferedAllocator(const DoubleBufferedAllocator&)
+                        = delete;
+                DoubleBufferedAllocator& operator=(
+                        const DoubleBufferedAllocator&) = delete;
+
+                //! Allow relocating the DoubleBufferedAllocator
+                DoubleBufferedAllocator(DoubleBufferedAllocator&&);
+                DoubleBufferedAllocator& operator=(DoubleBufferedAllocator&&);
+
+                //! Allocates a block from the current buffer.  Returns
+                //! nullptr if it is full.
+                inline void* allocate(size_t, size_t = DEFAULT_ALIGNMENT);
+                //! Does nothing.  (Memory is freed two ticks later.)
+                inline void deallocate(void*);
+
+                //! Begins a new frame:  swaps the buffers and frees everything
+                //! allocated two frames ago.
+                inline void tick();
+
+                //! Returns the buffer being allocated from.
+                inline LinearAllocator& getCurrentBuffer();
+                //! Returns the buffer holding last frame's allocations.
+                inline LinearAllocator& getPreviousBuffer();
+
+                //! Returns true if the provided pointer is inside either
+                //! buffer.
+                inline bool owns(const void*) const;
+                //! Returns the number of ticks so far.
+                inline size_t getFrame() const;
+
+                //! Sets the tag allocations are recorded under.
+                inline void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                inline MemoryTag getMemoryTag() const;
+
+            private:
+                //! The two buffers.
+                LinearAllocator _buffers[2];
+                //! The index of the current buffer.
+                size_t _current;
+                //! The number of ticks so far.
+                size_t _frame;
+        };
+
+    }
+}
+
+// Bring in inline implementations
+#include "DoubleBufferedAllocator-inl.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_DOUBLE_BUFFERED_ALLOCATOR_H
@@ -0,0 +1,68 @@
+/**
+ *  @file LinearAllocator-inl.h
+ *  @brief Inline implements: libxaos-core:memory/allocator/impl/LinearAllocator.h
+ *
+ *  This file provides inline implementations for the LinearAllocator class.
+ */
+
+#include <cassert>
+
+#include "memory/utility/alignment.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Allocation - the hot path.  Align the absolute address rather than
+        // the offset since the requested alignment may exceed the store's.
+        inline void* LinearAllocator::allocate(size_t size, size_t alignment) {
+            size_t start = _offset +
+                    getAlignmentOffset(_begin + _offset, alignment);
+
+            if (start > _capacity || size > _capacity - start ||
+                    (start + size > _committed && !grow(start + size))) {
+                // Not enough room.. leave ourselves alone.
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            recordAllocation(_tag, start + size - _offset);
+            _offset = start + size;
+            return _begin + start;
+        }
+        inline void LinearAllocator::deallocate(void*) {}
+
+        // Markers
+        inline LinearAllocator::Marker LinearAllocator::getMarker() const {
+            return _offset;
+        }
+        inline void LinearAllocator::rewind(Marker marker) {
+            assert(marker <= _offset); // Can't rewind forwards!
+            recordDeallocation(_tag, _offset - marker, 0);
+            _offset = marker;
+        }
+        inline void LinearAllocator::reset() {
+            recordDeallocation(_tag, _offset, 0);
+            _offset = 0;
+        }
+
+        // Queries
+        inline size_t LinearAllocator::getUsed() const {
+            return _offset;
+        }
+        inline size_t LinearAllocator::getCapacity() const {
+            return _capacity;
+        }
+        inline bool LinearAllocator::owns(const void* pointer) const {
+            const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+            return bytes >= _begin && bytes < _begin + _capacity;
+        }
+
+        // Tracking
+        inline void LinearAllocator::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        inline MemoryTag LinearAllocator::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
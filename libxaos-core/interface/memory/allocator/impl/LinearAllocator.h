@@ -0,0 +1,119 @@
+#ifndef     LIBXAOS_CORE_MEMORY_LINEAR_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_LINEAR_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A LinearAllocator hands out memory from an IStore by simply
+         *  bumping a pointer forward.
+         *
+         *  A LinearAllocator (also known as an "Arena" or "Bump" allocator)
+         *  carves allocations out of the raw storage of an IStore in order.
+         *  Individual allocations can NOT be freed.  Instead, the allocator can
+         *  be rewound to a previously acquired Marker (freeing everything
+         *  allocated after that Marker) or reset entirely (freeing everything).
+         *  Both operations are O(1).
+         *
+         *  This makes it ideal for per-frame scratch memory:  allocate freely
+         *  during the frame and call reset() once the frame is over.
+         *
+         *  Stores that back their memory on demand (i.e. VirtualStore) are
+         *  committed as the allocator's high-water mark rises.
+         *
+         *  Note that NO destructors are run when memory is rewound or reset.
+         *  If you place non-trivial objects in this allocator you are
+         *  responsible for destroying them yourself.
+         */
+        class LinearAllocator {
+
+            public:
+                //! Represents a position in the allocator that may be rewound
+                //! to.  (It's the number of bytes in use at the time.)
+                using Marker = size_t;
+
+                //! The alignment used when one isn't specified.
+                static constexpr const size_t DEFAULT_ALIGNMENT =
+                        alignof(std::max_align_t);
+
+                //! An IStore is required to allocate from.  (Acquires
+                //! ownership of the IStore.)
+                LinearAllocator(IStore*);
+                ~LinearAllocator();
+
+                //! No copying!  Two allocators can't own the same store.
+                LinearAllocator(const LinearAllocator&) = delete;
+                LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+                //! Allow relocating the LinearAllocator
+                LinearAllocator(LinearAllocator&&);
+                LinearAllocator& operator=(LinearAllocator&&);
+
+                /**
+                 *  @brief Allocates a block of memory of the provided size.
+                 *
+                 *  Returns a pointer to a block of at least size bytes aligned
+                 *  to the provided alignment (which must be a power of two).
+                 *  If the store cannot accommodate the request a nullptr is
+                 *  returned and the allocator is left unchanged.
+                 */
+                inline void* allocate(size_t,
+                        size_t = DEFAULT_ALIGNMENT);
+                //! Does nothing.  (Memory is freed by rewind() or reset().)
+                //! Lets the allocator be used through an Allocator.
+                inline void deallocate(void*);
+
+                //! Acquires a Marker for the current top of the allocator.
+                inline Marker getMarker() const;
+                //! Frees everything allocated after the provided Marker.
+                inline void rewind(Marker);
+                //! Frees everything in the allocator.
+                inline void reset();
+
+                //! Returns the number of bytes currently in use.
+                inline size_t getUsed() const;
+                //! Returns the total number of bytes this allocator manages.
+                inline size_t getCapacity() const;
+                //! Returns true if the provided pointer is inside this
+                //! allocator's store.
+                inline bool owns(const void*) const;
+
+                //! Sets the tag allocations are recorded under.  (Rewinds
+                //! are recorded as freeing bytes, not allocations.)
+                inline void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                inline MemoryTag getMemoryTag() const;
+
+            private:
+                //! Asks the store to back (at least) the provided number of
+                //! bytes.  Only called when we pass our committed size.
+                bool grow(size_t);
+
+                //! The store we allocate from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! Cached pointer to the beginning of the store.
+                uint8_t* _begin;
+                //! Cached size of the store.
+                size_t _capacity;
+                //! The number of bytes the store has backed for us.
+                size_t _committed;
+                //! The number of bytes handed out so far.
+                size_t _offset;
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+        };
+
+    }
+}
+
+// Bring in inline implementations
+#include "LinearAllocator-inl.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_LINEAR_ALLOCATOR_H
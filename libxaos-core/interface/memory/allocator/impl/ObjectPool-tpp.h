@@ -0,0 +1,80 @@
+/**
+ *  @file ObjectPool-tpp.h
+ *  @brief Template Implementations for ObjectPool.h
+ */
+
+#include <new>
+#include <utility>
+
+namespace libxaos {
+    namespace memory {
+
+        // Constructors
+        template<typename T>
+        ObjectPool<T>::ObjectPool(IStore* store) : _pool(store) {}
+        template<typename T>
+        ObjectPool<T>::~ObjectPool() {}
+
+        // Move Semantics (no copying pools!)
+        template<typename T>
+        ObjectPool<T>::ObjectPool(ObjectPool<T>&& other) :
+                _pool(std::move(other._pool)) {}
+        template<typename T>
+        ObjectPool<T>& ObjectPool<T>::operator=(ObjectPool<T>&& other) {
+            if (this != &other) {
+                _pool = std::move(other._pool);
+            }
+            return *this;
+        }
+
+        // Object Lifecycle
+        template<typename T>
+        template<typename... Args>
+        inline T* ObjectPool<T>::create(Args&&... args) {
+            void* block = _pool.allocate();
+            if (block == nullptr)
+                return nullptr;
+            return new (block) T(std::forward<Args>(args)...);
+        }
+        template<typename T>
+        inline void ObjectPool<T>::destroy(T* object) {
+            if (object == nullptr)
+                return;
+
+            object->~T();
+            _pool.deallocate(object);
+        }
+
+        // Queries
+        template<typename T>
+        inline bool ObjectPool<T>::owns(const T* object) const {
+            return _pool.owns(object);
+        }
+        template<typename T>
+        inline size_t ObjectPool<T>::getCapacity() const {
+            return _pool.getBlockCount();
+        }
+        template<typename T>
+        inline size_t ObjectPool<T>::getFreeCount() const {
+            return _pool.getFreeCount();
+        }
+        template<typename T>
+        inline bool ObjectPool<T>::isExhausted() const {
+            return _pool.isExhausted();
+        }
+        template<typename T>
+        inline size_t ObjectPool<T>::getExhaustedCount() const {
+            return _pool.getExhaustedCount();
+        }
+
+        // Tracking
+        template<typename T>
+        inline void ObjectPool<T>::setMemoryTag(MemoryTag tag) {
+            _pool.setMemoryTag(tag);
+        }
+        template<typename T>
+        inline MemoryTag ObjectPool<T>::getMemoryTag() const {
+            return _pool.getMemoryTag();
+        }
+    }
+}
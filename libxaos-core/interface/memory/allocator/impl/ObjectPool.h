@@ -0,0 +1,77 @@
+#ifndef     LIBXAOS_CORE_MEMORY_OBJECT_POOL_H
+#define     LIBXAOS_CORE_MEMORY_OBJECT_POOL_H
+
+#include <cstddef>
+
+#include "memory/allocator/impl/PoolAllocator.h"
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief An ObjectPool is a typed PoolAllocator.
+         *
+         *  An ObjectPool hands out blocks sized and aligned for a T and
+         *  constructs / destroys the T in place.  It's intended for objects
+         *  that are created and destroyed very frequently (ControlBlocks,
+         *  entities, etc.) and shouldn't each hit the global heap.
+         *
+         *  The pool does NOT track which objects are alive.  Any objects that
+         *  haven't been destroy()ed when the pool is destroyed are simply
+         *  abandoned (their destructors never run).
+         *
+         *  @tparam T the type of object this pool holds.
+         */
+        template<typename T>
+        class ObjectPool {
+
+            public:
+                //! An IStore is required to allocate from.  (Acquires
+                //! ownership of the IStore.)
+                ObjectPool(IStore*);
+                ~ObjectPool();
+
+                //! No copying!  Two pools can't own the same store.
+                ObjectPool(const ObjectPool<T>&) = delete;
+                ObjectPool<T>& operator=(const ObjectPool<T>&) = delete;
+
+                //! Allow relocating the ObjectPool
+                ObjectPool(ObjectPool<T>&&);
+                ObjectPool<T>& operator=(ObjectPool<T>&&);
+
+                //! Constructs a T in the pool.  Returns nullptr when exhausted.
+                template<typename... Args>
+                inline T* create(Args&&...);
+                //! Destroys a T and returns its memory to the pool.
+                inline void destroy(T*);
+
+                //! Returns true if the provided pointer is inside this pool.
+                inline bool owns(const T*) const;
+
+                //! Returns the total number of objects this pool can hold.
+                inline size_t getCapacity() const;
+                //! Returns the number of objects that can still be created.
+                inline size_t getFreeCount() const;
+                //! Returns true if the next create() would fail.
+                inline bool isExhausted() const;
+                //! Returns the number of times create() failed.
+                inline size_t getExhaustedCount() const;
+
+                //! Sets the tag objects are recorded under.
+                inline void setMemoryTag(MemoryTag);
+                //! Returns the tag objects are recorded under.
+                inline MemoryTag getMemoryTag() const;
+
+            private:
+                //! The underlying untyped pool.
+                PoolAllocator<sizeof(T), alignof(T)> _pool;
+        };
+
+    }
+}
+
+// Bring in template definitions.
+#include "ObjectPool-tpp.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_OBJECT_POOL_H
@@ -0,0 +1,178 @@
+/**
+ *  @file PoolAllocator-tpp.h
+ *  @brief Template Implementations for PoolAllocator.h
+ */
+
+#include <cassert>
+#include <utility>
+
+namespace libxaos {
+    namespace memory {
+
+        // Static Constants
+        template<size_t S, size_t A>
+        constexpr const size_t PoolAllocator<S, A>::ALIGNMENT;
+        template<size_t S, size_t A>
+        constexpr const size_t PoolAllocator<S, A>::BLOCK_SIZE;
+
+        // Constructors
+        template<size_t S, size_t A>
+        PoolAllocator<S, A>::PoolAllocator(IStore* store) : _store(store),
+                _begin(nullptr), _committedEnd(nullptr), _blockCount(0),
+                _touchedCount(0),
+                _usedCount(0), _exhaustedCount(0), _freeList(nullptr),
+                _tag(MEMORY_TAG_UNTAGGED) {
+            if (!_store)
+                return;
+
+            // Find our first aligned block and how many fit after it.
+            uint8_t* raw = _store->getRawStorage();
+            size_t padding = getAlignmentOffset(raw, ALIGNMENT);
+
+            if (padding < _store->SIZE) {
+                _begin = raw + padding;
+                _committedEnd = raw + _store->getCommitted();
+                _blockCount = (_store->SIZE - padding) / BLOCK_SIZE;
+            }
+        }
+        template<size_t S, size_t A>
+        PoolAllocator<S, A>::~PoolAllocator() {
+            recordDeallocation(_tag, _usedCount * BLOCK_SIZE, _usedCount);
+            if (_store)
+                delete _store;
+        }
+
+        // Move Semantics (no copying pools!)
+        template<size_t S, size_t A>
+        PoolAllocator<S, A>::PoolAllocator(PoolAllocator<S, A>&& other) :
+                _store(other._store), _begin(other._begin),
+                _committedEnd(other._committedEnd),
+                _blockCount(other._blockCount),
+                _touchedCount(other._touchedCount),
+                _usedCount(other._usedCount),
+                _exhaustedCount(other._exhaustedCount),
+                _freeList(other._freeList), _tag(other._tag) {
+            other._store = nullptr;
+            other._begin = nullptr;
+            other._committedEnd = nullptr;
+            other._blockCount = 0;
+            other._touchedCount = 0;
+            other._usedCount = 0;
+            other._exhaustedCount = 0;
+            other._freeList = nullptr;
+        }
+        template<size_t S, size_t A>
+        PoolAllocator<S, A>& PoolAllocator<S, A>::operator=(
+                PoolAllocator<S, A>&& other) {
+            if (this != &other) {
+                std::swap(_store, other._store);
+                std::swap(_begin, other._begin);
+                std::swap(_committedEnd, other._committedEnd);
+                std::swap(_blockCount, other._blockCount);
+                std::swap(_touchedCount, other._touchedCount);
+                std::swap(_usedCount, other._usedCount);
+                std::swap(_exhaustedCount, other._exhaustedCount);
+                std::swap(_freeList, other._freeList);
+                std::swap(_tag, other._tag);
+            }
+            return *this;
+        }
+
+        // Allocation
+        template<size_t S, size_t A>
+        inline void* PoolAllocator<S, A>::allocate() {
+            // Prefer recycled blocks; they're likely still in cache.
+            if (_freeList) {
+                FreeBlock* block = _freeList;
+                _freeList = block->next;
+                _usedCount++;
+                recordAllocation(_tag, BLOCK_SIZE);
+                return block;
+            }
+
+            // Otherwise bump out a block we've never touched.
+            if (_touchedCount < _blockCount) {
+                uint8_t* block = _begin + _touchedCount * BLOCK_SIZE;
+                if (block + BLOCK_SIZE > _committedEnd) {
+                    // Ask the store to back the new block.
+                    uint8_t* raw = _store->getRawStorage();
+                    if (_store->commit(static_cast<size_t>(
+                            block + BLOCK_SIZE - raw))) {
+                        _committedEnd = raw + _store->getCommitted();
+                    } else {
+                        _exhaustedCount++;
+                        recordAllocationFailure(_tag, BLOCK_SIZE);
+                        return nullptr;
+                    }
+                }
+
+                _touchedCount++;
+                _usedCount++;
+                recordAllocation(_tag, BLOCK_SIZE);
+                return block;
+            }
+
+            _exhaustedCount++;
+            recordAllocationFailure(_tag, BLOCK_SIZE);
+            return nullptr;
+        }
+        template<size_t S, size_t A>
+        inline void* PoolAllocator<S, A>::allocate(size_t size,
+                size_t alignment) {
+            if (size > BLOCK_SIZE || alignment > ALIGNMENT) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+            return allocate();
+        }
+        template<size_t S, size_t A>
+        void PoolAllocator<S, A>::deallocate(void* pointer) {
+            if (pointer == nullptr)
+                return;
+
+            assert(owns(pointer)); // Not one of ours!
+            assert((static_cast<uint8_t*>(pointer) - _begin) % BLOCK_SIZE
+                    == 0); // Not the start of a block!
+            assert(_usedCount > 0); // Double free?
+
+            FreeBlock* block = static_cast<FreeBlock*>(pointer);
+            block->next = _freeList;
+            _freeList = block;
+            _usedCount--;
+            recordDeallocation(_tag, BLOCK_SIZE);
+        }
+
+        // Queries
+        template<size_t S, size_t A>
+        inline bool PoolAllocator<S, A>::owns(const void* pointer) const {
+            const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+            return bytes >= _begin && bytes < _begin + _blockCount * BLOCK_SIZE;
+        }
+        template<size_t S, size_t A>
+        inline size_t PoolAllocator<S, A>::getBlockCount() const {
+            return _blockCount;
+        }
+        template<size_t S, size_t A>
+        inline size_t PoolAllocator<S, A>::getFreeCount() const {
+            return _blockCount - _usedCount;
+        }
+        template<size_t S, size_t A>
+        inline bool PoolAllocator<S, A>::isExhausted() const {
+            return _usedCount == _blockCount;
+        }
+        template<size_t S, size_t A>
+        inline size_t PoolAllocator<S, A>::getExhaustedCount() const {
+            return _exhaustedCount;
+        }
+
+        // Tracking
+        template<size_t S, size_t A>
+        inline void PoolAllocator<S, A>::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        template<size_t S, size_t A>
+        inline MemoryTag PoolAllocator<S, A>::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef     LIBXAOS_CORE_MEMORY_POOL_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A PoolAllocator partitions an IStore into fixed size blocks.
+         *
+         *  A PoolAllocator hands out blocks of a single, fixed size from the
+         *  raw storage of an IStore.  Freed blocks are threaded onto an
+         *  intrusive free list (the "next" pointer lives inside the free block
+         *  itself) so both allocate() and deallocate() are O(1) and there is
+         *  no per-block bookkeeping overhead.
+         *
+         *  Blocks that have never been handed out are not threaded onto the
+         *  free list up front; they are bumped out of the store on demand.  As
+         *  such, constructing a PoolAllocator is O(1) regardless of the store's
+         *  size.
+         *
+         *  When the pool runs out of blocks, allocate() returns a nullptr and
+         *  the failure is recorded (see getExhaustedCount()).
+         *
+         *  @tparam S the size_t of bytes each block must hold.
+         *  @tparam A the size_t at which each block should be aligned.
+         */
+        template<size_t S, size_t A = alignof(std::max_align_t)>
+        class PoolAllocator {
+            static_assert(S > 0, "A PoolAllocator can't hold empty blocks!");
+            static_assert(isPowerOfTwo(A),
+                    "A PoolAllocator's alignment must be a power of two!");
+
+            public:
+                //! The actual alignment of each block.  (It needs to be able
+                //! to hold a pointer when it's free.)
+                static constexpr const size_t ALIGNMENT =
+                        A > alignof(void*) ? A : alignof(void*);
+                //! The actual size, in bytes, of each block.
+                static constexpr const size_t BLOCK_SIZE = alignUp(
+                        S > sizeof(void*) ? S : sizeof(void*), ALIGNMENT);
+
+                //! An IStore is required to allocate from.  (Acquires
+                //! ownership of the IStore.)
+                PoolAllocator(IStore*);
+                ~PoolAllocator();
+
+                //! No copying!  Two allocators can't own the same store.
+                PoolAllocator(const PoolAllocator<S, A>&) = delete;
+                PoolAllocator<S, A>& operator=(const PoolAllocator<S, A>&)
+                        = delete;
+
+                //! Allow relocating the PoolAllocator
+                PoolAllocator(PoolAllocator<S, A>&&);
+                PoolAllocator<S, A>& operator=(PoolAllocator<S, A>&&);
+
+                //! Acquires a single block.  Returns nullptr when exhausted.
+                inline void* allocate();
+                //! Acquires a single block if the provided size and alignment
+                //! fit in one (or returns nullptr).  Lets the pool be used
+                //! through an Allocator.
+                inline void* allocate(size_t, size_t = ALIGNMENT);
+                //! Returns a block to the pool.  (nullptr is ignored.)
+                void deallocate(void*);
+
+                //! Returns true if the provided pointer is inside this pool.
+                inline bool owns(const void*) const;
+
+                //! Returns the total number of blocks in this pool.
+                inline size_t getBlockCount() const;
+                //! Returns the number of blocks available for allocation.
+                inline size_t getFreeCount() const;
+                //! Returns true if the next allocate() would fail.
+                inline bool isExhausted() const;
+                //! Returns the number of times allocate() failed.
+                inline size_t getExhaustedCount() const;
+
+                //! Sets the tag allocations are recorded under.
+                inline void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                inline MemoryTag getMemoryTag() const;
+
+            private:
+                //! Overlays a free block.
+                struct FreeBlock {
+                    FreeBlock* next;
+                };
+
+                //! The store we allocate from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! The first (aligned) block in the store.
+                uint8_t* _begin;
+                //! The end of the memory the store has backed for us.
+                uint8_t* _committedEnd;
+                //! The total number of blocks in the store.
+                size_t _blockCount;
+                //! The number of blocks that have ever been handed out.
+                size_t _touchedCount;
+                //! The number of blocks currently handed out.
+                size_t _usedCount;
+                //! The number of failed allocations.
+                size_t _exhaustedCount;
+                //! The head of the free list.
+                FreeBlock* _freeList;
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+        };
+
+    }
+}
+
+// Bring in template definitions.
+#include "PoolAllocator-tpp.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_POOL_ALLOCATOR_H
@@ -0,0 +1,171 @@
+#ifndef     LIBXAOS_CORE_MEMORY_RELOCATABLE_HEAP_H
+#define     LIBXAOS_CORE_MEMORY_RELOCATABLE_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A RelocatableHeap hands out Handles to memory it may move.
+         *
+         *  A RelocatableHeap allocates variable sized blocks from an IStore,
+         *  but clients hold Handles rather than pointers.  A Handle is
+         *  resolved into a pointer when the memory is needed.  Because nobody
+         *  keeps the pointers, the heap is free to slide blocks down over
+         *  the holes left by freed ones and keep its footprint flat no matter
+         *  how long it's used.
+         *
+         *  Compaction is incremental:  defragment() moves blocks (using
+         *  memmove) until a time budget runs out and picks up where it left
+         *  off next time.  Calling it once per frame with a small budget is
+         *  the intended use.
+         *
+         *  Handles carry a generation.  Once a block is freed, every Handle
+         *  to it resolves to nullptr (even if its slot has been reused).
+         *
+         *  Pointers returned by resolve() are only valid until the next call
+         *  to defragment().  Blocks are aligned to ALIGNMENT.  The whole store
+         *  is committed up front; the handle table lives at its end.
+         *
+         *  This class is NOT thread safe.
+         */
+        class RelocatableHeap {
+
+            public:
+                //! The alignment of every block.
+                static constexpr const size_t ALIGNMENT = 16;
+                //! The number of handles when one isn't specified.
+                static constexpr const size_t DEFAULT_MAX_HANDLES = 1024;
+
+                //! Refers to a block in the heap.  (A default constructed
+                //! Handle refers to nothing.)
+                struct Handle {
+                    constexpr Handle() : index(0), generation(0) {}
+                    constexpr Handle(uint32_t i, uint32_t g) :
+                            index(i), generation(g) {}
+
+                    uint32_t index;
+                    uint32_t generation;
+                };
+
+                //! A snapshot of the heap's usage.
+                struct Statistics {
+                    //! Bytes currently handed out (including headers).
+                    size_t usedBytes;
+                    //! Bytes currently available.
+                    size_t freeBytes;
+                    //! Free bytes stuck in holes between blocks.
+                    size_t holeBytes;
+                    //! The number of live Handles.
+                    size_t handleCount;
+                    //! holeBytes / freeBytes.  Zero means the heap is
+                    //! compact.
+                    double fragmentation;
+                };
+
+                //! An IStore is required to allocate from, and optionally the
+                //! number of handles that may be live at once.  (Acquires
+                //! ownership of the IStore.)
+                RelocatableHeap(IStore*, size_t = DEFAULT_MAX_HANDLES);
+                ~RelocatableHeap();
+
+                //! No copying!  Two heaps can't own the same store.
+                RelocatableHeap(const RelocatableHeap&) = delete;
+                RelocatableHeap& operator=(const RelocatableHeap&) = delete;
+
+                //! No moving either.  (There's no need; use Handles.)
+                RelocatableHeap(RelocatableHeap&&) = delete;
+                RelocatableHeap& operator=(RelocatableHeap&&) = delete;
+
+                //! Allocates a block of (at least) the provided size.  Returns
+                //! an invalid Handle if there's no room (or no handles).
+                Handle allocate(size_t);
+                //! Frees the block a Handle refers to.  (Invalid Handles are
+                //! ignored.)
+                void deallocate(Handle);
+
+                //! Returns a pointer to the block (nullptr if the Handle is
+                //! stale).  Valid until the next defragment().
+                void* resolve(Handle) const;
+                //! Returns true if the Handle refers to a live block.
+                bool isValid(Handle) const;
+                //! Returns the usable size of the block.
+                size_t getSize(Handle) const;
+
+                /**
+                 *  @brief Compacts the heap for (about) the provided number of
+                 *  microseconds.
+                 *
+                 *  Blocks are slid towards the start of the store, closing
+                 *  the holes between them.  At least one block is moved (if
+                 *  any need to be) regardless of the budget.  Returns the
+                 *  number of bytes moved.
+                 */
+                size_t defragment(unsigned int);
+                //! Returns true if there are no holes left to close.
+                bool isCompact() const;
+
+                //! Gathers usage statistics.
+                Statistics getStatistics() const;
+
+                //! Sets the tag allocations are recorded under.
+                void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                MemoryTag getMemoryTag() const;
+
+            private:
+                //! Precedes every block (used or free).
+                struct BlockHeader {
+                    size_t size;
+                    uint32_t handle;
+                };
+                //! Maps a Handle to its block.
+                struct HandleEntry {
+                    size_t offset;
+                    uint32_t generation;
+                    uint32_t nextFree;
+                };
+
+                //! Returns the header at an offset.
+                BlockHeader* getBlock(size_t) const;
+                //! Returns the entry for a Handle (nullptr if it's stale).
+                HandleEntry* getEntry(Handle) const;
+                //! Finds a hole (first fit) that can hold the block.
+                size_t findHole(size_t);
+
+                //! The store we allocate from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! The first block.
+                uint8_t* _begin;
+                //! The number of bytes available to blocks.
+                size_t _capacity;
+                //! The end of the last block.
+                size_t _top;
+                //! Nothing below this offset is free.
+                size_t _compactFrom;
+                //! Bytes in free blocks below _top.
+                size_t _holeBytes;
+                //! Bytes in used blocks.
+                size_t _usedBytes;
+                //! The handle table.  (Lives at the end of the store.)
+                HandleEntry* _handles;
+                //! The number of entries in the handle table.
+                size_t _handleCapacity;
+                //! The first unused entry.
+                uint32_t _freeHandle;
+                //! The number of live Handles.
+                size_t _handleCount;
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_RELOCATABLE_HEAP_H
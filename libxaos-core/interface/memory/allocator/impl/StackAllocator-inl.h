@@ -0,0 +1,100 @@
+/**
+ *  @file StackAllocator-inl.h
+ *  @brief Inline implements: libxaos-core:memory/allocator/impl/StackAllocator.h
+ *
+ *  This file provides inline implementations for the StackAllocator class.
+ */
+
+#include <cassert>
+
+#include "memory/utility/alignment.h"
+
+namespace libxaos {
+    namespace memory {
+
+        // Allocation - the hot path.  Align absolute addresses rather than
+        // offsets since the requested alignment may exceed the store's.
+        inline void* StackAllocator::allocate(size_t size, size_t alignment) {
+            size_t start = _bottom +
+                    getAlignmentOffset(_begin + _bottom, alignment);
+
+            if (start > _top || size > _top - start) {
+                // We'd run into the top.. leave ourselves alone.
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            recordAllocation(_tag, start + size - _bottom);
+            _bottom = start + size;
+            return _begin + start;
+        }
+        inline void* StackAllocator::allocateTop(size_t size,
+                size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+            if (size > _top - _bottom) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            uint8_t* block = alignDown(_begin + _top - size, alignment);
+            if (block < _begin + _bottom) {
+                recordAllocationFailure(_tag, size);
+                return nullptr;
+            }
+
+            size_t start = static_cast<size_t>(block - _begin);
+            recordAllocation(_tag, _top - start);
+            _top = start;
+            return block;
+        }
+        inline void StackAllocator::deallocate(void*) {}
+
+        // Markers
+        inline StackAllocator::Marker StackAllocator::getMarker() const {
+            return _bottom;
+        }
+        inline void StackAllocator::rewind(Marker marker) {
+            assert(marker <= _bottom); // Can't rewind forwards!
+            recordDeallocation(_tag, _bottom - marker, 0);
+            _bottom = marker;
+        }
+        inline StackAllocator::Marker StackAllocator::getTopMarker() const {
+            return _top;
+        }
+        inline void StackAllocator::rewindTop(Marker marker) {
+            assert(marker >= _top && marker <= _capacity); // Forwards!
+            recordDeallocation(_tag, marker - _top, 0);
+            _top = marker;
+        }
+        inline void StackAllocator::reset() {
+            rewind(0);
+            rewindTop(_capacity);
+        }
+
+        // Queries
+        inline size_t StackAllocator::getUsed() const {
+            return _bottom;
+        }
+        inline size_t StackAllocator::getTopUsed() const {
+            return _capacity - _top;
+        }
+        inline size_t StackAllocator::getFree() const {
+            return _top - _bottom;
+        }
+        inline size_t StackAllocator::getCapacity() const {
+            return _capacity;
+        }
+        inline bool StackAllocator::owns(const void* pointer) const {
+            const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+            return bytes >= _begin && bytes < _begin + _capacity;
+        }
+
+        // Tracking
+        inline void StackAllocator::setMemoryTag(MemoryTag tag) {
+            _tag = tag;
+        }
+        inline MemoryTag StackAllocator::getMemoryTag() const {
+            return _tag;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef     LIBXAOS_CORE_MEMORY_STACK_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_STACK_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A StackAllocator hands out memory from both ends of an IStore
+         *  and frees it in LIFO order.
+         *
+         *  Like a LinearAllocator, allocations are made by bumping an offset
+         *  and can only be freed by rewinding to a Marker.  Unlike one, there
+         *  are two stacks:  the bottom grows up from the start of the store
+         *  and the top grows down from its end.  The store is full when they
+         *  meet.  The usual pattern is to keep long-lived data at the bottom
+         *  and temporaries at the top (or vice versa), so that freeing the
+         *  temporaries never strands the long-lived data.
+         *
+         *  A Scope captures both ends when it's constructed and rewinds them
+         *  when it's destroyed, freeing everything allocated while it was
+         *  alive in O(1).  Scopes must be destroyed in the reverse order they
+         *  were created (which is what C++ does anyway).
+         *
+         *  The whole store is committed up front (the top needs its end).
+         *
+         *  Note that NO destructors are run when memory is rewound.  If you
+         *  place non-trivial objects in this allocator you are responsible
+         *  for destroying them yourself.
+         *
+         *  This class is NOT thread safe.
+         */
+        class StackAllocator {
+
+            public:
+                //! A position in one of the stacks.  (It's an offset from the
+                //! start of the store.)
+                using Marker = size_t;
+
+                //! The alignment used when one isn't specified.
+                static constexpr const size_t DEFAULT_ALIGNMENT =
+                        alignof(std::max_align_t);
+
+                /**
+                 *  @brief Rewinds both ends of a StackAllocator when it goes
+                 *  out of scope.
+                 */
+                class Scope {
+                    public:
+                        //! Captures both ends of the allocator.
+                        Scope(StackAllocator&);
+                        //! Rewinds both ends to where they were.
+                        ~Scope();
+
+                        //! Scopes are bound to a block; no copying or moving.
+                        Scope(const Scope&) = delete;
+                        Scope& operator=(const Scope&) = delete;
+                        Scope(Scope&&) = delete;
+                        Scope& operator=(Scope&&) = delete;
+
+                    private:
+                        //! The allocator to rewind.
+                        StackAllocator& _allocator;
+                        //! Where the bottom was.
+                        Marker _bottom;
+                        //! Where the top was.
+                        Marker _top;
+                };
+
+                //! An IStore is required to allocate from.  (Acquires
+                //! ownership of the IStore.)
+                StackAllocator(IStore*);
+                ~StackAllocator();
+
+                //! No copying!  Two allocators can't own the same store.
+                StackAllocator(const StackAllocator&) = delete;
+                StackAllocator& operator=(const StackAllocator&) = delete;
+
+                //! Allow relocating the StackAllocator.  (Not while a Scope
+                //! refers to it!)
+                StackAllocator(StackAllocator&&);
+                StackAllocator& operator=(StackAllocator&&);
+
+                /**
+                 *  @brief Allocates a block from the bottom of the store.
+                 *
+                 *  Returns a pointer to a block of at least size bytes aligned
+                 *  to the provided alignment (which must be a power of two).
+                 *  If it would run into the top a nullptr is returned and the
+                 *  allocator is left unchanged.
+                 */
+                inline void* allocate(size_t, size_t = DEFAULT_ALIGNMENT);
+                //! Allocates a block from the top of the store.  (Otherwise
+                //! identical to allocate().)
+                inline void* allocateTop(size_t, size_t = DEFAULT_ALIGNMENT);
+                //! Does nothing.  (Memory is freed by rewinding.)  Lets the
+                //! allocator be used through an Allocator.
+                inline void deallocate(void*);
+
+                //! Acquires a Marker for the bottom stack.
+                inline Marker getMarker() const;
+                //! Frees everything allocated from the bottom after the
+                //! provided Marker.
+                inline void rewind(Marker);
+                //! Acquires a Marker for the top stack.
+                inline Marker getTopMarker() const;
+                //! Frees everything allocated from the top after the provided
+                //! Marker.
+                inline void rewindTop(Marker);
+                //! Frees everything (at both ends).
+                inline void reset();
+
+                //! Returns the number of bytes used at the bottom.
+                inline size_t getUsed() const;
+                //! Returns the number of bytes used at the top.
+                inline size_t getTopUsed() const;
+                //! Returns the number of bytes between the two stacks.
+                inline size_t getFree() const;
+                //! Returns the total number of bytes this allocator manages.
+                inline size_t getCapacity() const;
+                //! Returns true if the provided pointer is inside this
+                //! allocator's store.
+                inline bool owns(const void*) const;
+
+                //! Sets the tag allocations are recorded under.  (Rewinds
+                //! are recorded as freeing bytes, not allocations.)
+                inline void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                inline MemoryTag getMemoryTag() const;
+
+            private:
+                //! The store we allocate from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! Cached pointer to the beginning of the store.
+                uint8_t* _begin;
+                //! Cached size of the store.
+                size_t _capacity;
+                //! The end of the bottom stack.
+                size_t _bottom;
+                //! The start of the top stack.
+                size_t _top;
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+        };
+
+    }
+}
+
+// Bring in inline implementations
+#include "StackAllocator-inl.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_STACK_ALLOCATOR_H
@@ -0,0 +1,161 @@
+#ifndef     LIBXAOS_CORE_MEMORY_TLSF_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_TLSF_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A TLSFAllocator is a general purpose allocator with bounded,
+         *  constant time allocation and deallocation.
+         *
+         *  A TLSFAllocator implements the "Two-Level Segregated Fit" algorithm
+         *  (Masmano et al.) over the raw storage of an IStore.  Free blocks are
+         *  kept in lists segregated first by power of two and then linearly
+         *  subdivided within each power of two.  A pair of bitmaps records
+         *  which lists are non-empty so a suitable block can always be found
+         *  with a couple of bit scans.  Adjacent free blocks are coalesced
+         *  immediately when freed.
+         *
+         *  As such, allocate(), deallocate(), and reallocate() (when it can
+         *  grow or shrink in place) are all O(1) with no hidden worst cases,
+         *  which makes this allocator suitable for frame-critical code.
+         *
+         *  Every allocation costs a single word of overhead.  Allocations are
+         *  aligned to DEFAULT_ALIGNMENT unless a larger alignment is requested.
+         *  (Reallocations that must move are aligned to DEFAULT_ALIGNMENT.)
+         *
+         *  The whole store is committed up front (see IStore::commit()).
+         *
+         *  This class is NOT thread safe.
+         */
+        class TLSFAllocator {
+
+            public:
+                //! The alignment every allocation is guaranteed to have.
+                static constexpr const size_t DEFAULT_ALIGNMENT =
+                        sizeof(void*) >= 8 ? 8 : 4;
+
+                //! The header of every block.  (Opaque; defined in the
+                //! implementation.)
+                struct Block;
+
+                //! log2 of DEFAULT_ALIGNMENT
+                static constexpr const size_t ALIGN_SIZE_LOG2 =
+                        sizeof(void*) >= 8 ? 3 : 2;
+                //! log2 of the number of second level lists per first level.
+                static constexpr const size_t SL_INDEX_COUNT_LOG2 = 5;
+                //! The number of second level lists per first level.
+                static constexpr const size_t SL_INDEX_COUNT =
+                        1 << SL_INDEX_COUNT_LOG2;
+                //! log2 of the largest block we can manage.
+                static constexpr const size_t FL_INDEX_MAX =
+                        sizeof(void*) >= 8 ? 32 : 30;
+                //! Blocks smaller than 1 << FL_INDEX_SHIFT share one level.
+                static constexpr const size_t FL_INDEX_SHIFT =
+                        SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2;
+                //! The number of first level lists.
+                static constexpr const size_t FL_INDEX_COUNT =
+                        FL_INDEX_MAX - FL_INDEX_SHIFT + 1;
+
+                //! A snapshot of the allocator's usage.
+                struct Statistics {
+                    //! Bytes currently handed out (excluding overhead).
+                    size_t usedBytes;
+                    //! Bytes currently available (in all free blocks).
+                    size_t freeBytes;
+                    //! The largest single allocation that could succeed.
+                    size_t largestFreeBlock;
+                    //! The number of live allocations.
+                    size_t allocationCount;
+                    //! 1 - (largestFreeBlock / freeBytes).  Zero means all
+                    //! free memory is contiguous.
+                    double fragmentation;
+                };
+
+                //! An IStore is required to allocate from.  (Acquires
+                //! ownership of the IStore.)
+                TLSFAllocator(IStore*);
+                ~TLSFAllocator();
+
+                //! No copying!  Two allocators can't own the same store.
+                TLSFAllocator(const TLSFAllocator&) = delete;
+                TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+
+                //! No moving either.  Free lists point into this object.
+                TLSFAllocator(TLSFAllocator&&) = delete;
+                TLSFAllocator& operator=(TLSFAllocator&&) = delete;
+
+                //! Allocates a block of (at least) the provided size and
+                //! alignment.  Returns nullptr if no block is large enough.
+                void* allocate(size_t, size_t = DEFAULT_ALIGNMENT);
+                //! Returns a block to the allocator.  (nullptr is ignored.)
+                void deallocate(void*);
+                //! Resizes a block, moving it if needed.  Behaves like
+                //! std::realloc.
+                void* reallocate(void*, size_t);
+
+                //! Returns true if the provided pointer is inside this
+                //! allocator's store.
+                bool owns(const void*) const;
+                //! Returns the usable size of an allocated block.
+                size_t getAllocationSize(const void*) const;
+
+                //! Gathers usage statistics.  This walks (at most) a single
+                //! free list to find the largest free block.
+                Statistics getStatistics() const;
+
+                //! Sets the tag allocations are recorded under.
+                void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                MemoryTag getMemoryTag() const;
+
+            private:
+                // Free list management
+                void insertFreeBlock(Block*, size_t, size_t);
+                void removeFreeBlock(Block*, size_t, size_t);
+                void insertBlock(Block*);
+                void removeBlock(Block*);
+                Block* searchSuitableBlock(size_t&, size_t&) const;
+
+                // Splitting and merging
+                Block* mergePrevious(Block*);
+                Block* mergeNext(Block*);
+                void trimFree(Block*, size_t);
+                void trimUsed(Block*, size_t);
+                Block* trimFreeLeading(Block*, size_t);
+                Block* locateFree(size_t);
+                void* prepareUsed(Block*, size_t);
+
+                //! The store we allocate from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! The first byte of the managed region.
+                uint8_t* _begin;
+                //! The last byte (exclusive) of the managed region.
+                uint8_t* _end;
+                //! Bytes currently handed out.
+                size_t _usedBytes;
+                //! Bytes currently sitting in free lists.
+                size_t _freeBytes;
+                //! Number of live allocations.
+                size_t _allocationCount;
+                //! Which first level lists have free blocks.
+                uint32_t _flBitmap;
+                //! Which second level lists have free blocks.
+                uint32_t _slBitmap[FL_INDEX_COUNT];
+                //! The heads of the free lists.
+                Block* _blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_TLSF_ALLOCATOR_H
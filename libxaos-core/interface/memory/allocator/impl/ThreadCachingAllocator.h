@@ -0,0 +1,174 @@
+#ifndef     LIBXAOS_CORE_MEMORY_THREAD_CACHING_ALLOCATOR_H
+#define     LIBXAOS_CORE_MEMORY_THREAD_CACHING_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "memory/store/IStore.h"
+#include "memory/utility/tracking.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A ThreadCachingAllocator is a general purpose, thread safe
+         *  allocator designed to replace the system allocator.
+         *
+         *  Small allocations (up to MAX_SMALL_SIZE) are rounded up to one of
+         *  SIZE_CLASS_COUNT size classes.  The IStore is carved into spans of
+         *  SPAN_SIZE bytes and each span is dedicated to a single size class.
+         *
+         *  Every thread keeps a cache of free objects for each size class, so
+         *  the common case of allocate() and deallocate() touches no locks at
+         *  all.  When a thread's cache runs dry it grabs a batch of objects
+         *  from that class's central depot; when it holds too many (i.e. it
+         *  is freeing objects that another thread allocated) it returns a
+         *  batch to the depot.  A thread's cache is returned to the depots
+         *  when the thread exits.
+         *
+         *  Large allocations (and small ones once the store is full) are
+         *  forwarded to std::malloc.
+         *
+         *  Up to MAX_INSTANCES allocators may exist at once with thread
+         *  caches; any beyond that still work but always use the depots.  An
+         *  allocator must outlive every thread that uses it (or those threads
+         *  must call flushThreadCache() before it is destroyed).
+         */
+        class ThreadCachingAllocator {
+
+            public:
+                //! The size, in bytes, of each span carved from the store.
+                static constexpr const size_t SPAN_SIZE = 64 * 1024;
+                //! The largest allocation served from the size classes.
+                static constexpr const size_t MAX_SMALL_SIZE = 32 * 1024;
+                //! The number of size classes.
+                static constexpr const size_t SIZE_CLASS_COUNT = 40;
+                //! The alignment every allocation is guaranteed to have.
+                static constexpr const size_t DEFAULT_ALIGNMENT = 16;
+                //! The number of allocators that may have thread caches.
+                static constexpr const size_t MAX_INSTANCES = 16;
+
+                //! The cache of free objects a thread holds (opaque).
+                struct ThreadCache;
+
+                //! An IStore is required to allocate from.  (Acquires
+                //! ownership of the IStore.)
+                ThreadCachingAllocator(IStore*);
+                ~ThreadCachingAllocator();
+
+                //! No copying or moving.  Threads hold on to this object.
+                ThreadCachingAllocator(const ThreadCachingAllocator&) = delete;
+                ThreadCachingAllocator& operator=(
+                        const ThreadCachingAllocator&) = delete;
+                ThreadCachingAllocator(ThreadCachingAllocator&&) = delete;
+                ThreadCachingAllocator& operator=(ThreadCachingAllocator&&)
+                        = delete;
+
+                //! Allocates a block of (at least) the provided size and
+                //! alignment.  Returns nullptr only if the system is out of
+                //! memory too.
+                void* allocate(size_t, size_t = DEFAULT_ALIGNMENT);
+                //! Returns a block to the allocator.  May be called from any
+                //! thread.  (nullptr is ignored.)
+                void deallocate(void*);
+
+                //! Returns true if the provided pointer lies in this
+                //! allocator's store.  (Large allocations are not included.)
+                bool owns(const void*) const;
+                //! Returns the usable size of an allocated block.
+                size_t getAllocationSize(const void*) const;
+                //! Returns the number of spans carved from the store so far.
+                size_t getSpanCount() const;
+
+                //! Returns all of the calling thread's cached objects to the
+                //! central depots.
+                void flushThreadCache();
+
+                //! Sets the tag allocations are recorded under.  (Set it
+                //! before other threads start allocating.)
+                void setMemoryTag(MemoryTag);
+                //! Returns the tag allocations are recorded under.
+                MemoryTag getMemoryTag() const;
+
+                //! Returns the size class a small allocation falls into.
+                static size_t getSizeClass(size_t);
+                //! Returns the size of the objects in a size class.
+                static size_t getClassSize(size_t);
+
+            private:
+                //! A free object (overlays the object's memory).
+                struct FreeObject {
+                    FreeObject* next;
+                };
+                //! The shared pool of free objects for a size class.
+                struct Depot {
+                    Depot() : mutex(), head(nullptr), count(0) {}
+
+                    std::mutex mutex;
+                    FreeObject* head;
+                    size_t count;
+                };
+                //! The thread local caches for every instance.
+                struct ThreadCacheSlots;
+
+                //! Finds (or creates) the calling thread's cache.
+                ThreadCache* getThreadCache();
+                //! Returns a cache's objects to the depots and recycles it.
+                void releaseThreadCache(ThreadCache*);
+                //! Moves a batch of objects from the depot into the cache.
+                bool refill(ThreadCache*, size_t);
+                //! Moves a batch of objects from the cache into the depot.
+                void drain(ThreadCache*, size_t, size_t);
+                //! Carves a new span for the size class into its depot.
+                //! (The depot's mutex must be held.)
+                bool carveSpan(size_t);
+                //! Commits the store up to the end of the provided number of
+                //! spans.
+                bool commitSpans(size_t);
+                //! Finds a span for the allocator's own bookkeeping.
+                //! (_spanMutex must be held.)
+                uint8_t* carveMetadata(size_t);
+
+                //! Small allocations without a thread cache.
+                void* allocateFromDepot(size_t);
+                //! Allocations too big (or too aligned) for the spans.
+                void* allocateLarge(size_t, size_t);
+
+                //! The store we carve spans from.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _store;
+                //! The beginning of the first span (the store's beginning,
+                //! aligned up to DEFAULT_ALIGNMENT).
+                uint8_t* _begin;
+                //! The size class of every span. (Lives in the store.)
+                uint8_t* _spanClasses;
+                //! The total number of spans the store can hold.
+                size_t _spanCapacity;
+                //! The number of spans carved so far.
+                std::atomic<size_t> _spanCount;
+                //! Guards carving spans and the metadata below.
+                std::mutex _spanMutex;
+                //! The current metadata span (and how much of it is used).
+                uint8_t* _metadata;
+                size_t _metadataUsed;
+                //! ThreadCaches left behind by exited threads.
+                ThreadCache* _spareCaches;
+                //! The central depots.
+                Depot _depots[SIZE_CLASS_COUNT];
+                //! Our thread cache slot (MAX_INSTANCES if none).
+                size_t _slot;
+                //! The generation of our thread cache slot.
+                uint32_t _generation;
+                //! The tag allocations are recorded under.
+                MemoryTag _tag;
+
+                //! The calling thread's caches.
+                static thread_local ThreadCacheSlots _threadSlots;
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_THREAD_CACHING_ALLOCATOR_H
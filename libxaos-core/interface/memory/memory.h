@@ -1 +1,32 @@
+/**
+ *  @file memory.h
+ *  @brief The libxaos Memory Manager
+ *
+ *  This file exposes the process wide allocator libxaos uses by default.  It
+ *  is a ThreadCachingAllocator backed by a (very large) VirtualStore, so only
+ *  the memory actually used is ever committed.
+ *
+ *  The global allocator can also replace the global operator new and
+ *  operator delete (and their array and nothrow variants).  This is opt-in;
+ *  define the following flag when compiling libxaos-core:
+ *  - LIBXAOS_FLAG_REPLACE_GLOBAL_NEW : Route new / delete to the global
+ *    allocator.
+ */
 
+#ifndef     LIBXAOS_CORE_MEMORY_MEMORY_H
+#define     LIBXAOS_CORE_MEMORY_MEMORY_H
+
+#include "memory/allocator/impl/ThreadCachingAllocator.h"
+
+namespace libxaos {
+    namespace memory {
+
+        //! Returns the process wide allocator.  It is created on first use
+        //! and is never destroyed (so it may be used during static
+        //! destruction).
+        ThreadCachingAllocator& getGlobalAllocator();
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_MEMORY_H
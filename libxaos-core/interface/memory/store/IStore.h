@@ -16,6 +16,12 @@ namespace libxaos {
          *  a store or not but, generally, this is not a good idea.
          *
          *  To ensure ease of use, a Store should be default constructable.
+         *
+         *  A store may choose to only back part of its memory at any given
+         *  time (see commit()).  Users that fill a store progressively should
+         *  call commit() whenever their high-water mark passes
+         *  getCommitted().  Stores that are always fully backed need not
+         *  override either method.
          */
         class IStore {
 
@@ -43,9 +49,22 @@ namespace libxaos {
                  */
                 virtual uint8_t* getRawStorage() = 0;
 
+                /**
+                 *  @brief Ensures the first N bytes of the store are usable.
+                 *
+                 *  This method requests that the first N bytes (starting at
+                 *  getRawStorage()) be backed by real memory.  It returns false
+                 *  if that isn't possible (i.e. N exceeds SIZE).  Committing
+                 *  never moves the storage.
+                 */
+                virtual bool commit(size_t size) { return size <= SIZE; }
+                //! Returns the number of bytes currently usable.
+                virtual size_t getCommitted() const { return SIZE; }
+
                 //! The size_t, in bytes, which this store contains.
                 const size_t SIZE;
-                //! The short at which the data should be aligned.
+                //! The short at which the data is aligned.  getRawStorage()
+                //! MUST return an address that is a multiple of this value.
                 const unsigned short ALIGNMENT;
         };
 
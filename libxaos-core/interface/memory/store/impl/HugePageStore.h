@@ -0,0 +1,83 @@
+#ifndef     LIBXAOS_CORE_MEMORY_HUGE_PAGE_STORE_H
+#define     LIBXAOS_CORE_MEMORY_HUGE_PAGE_STORE_H
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A HugePageStore backs its data with huge (large) pages.
+         *
+         *  A HugePageStore acquires its memory directly from the operating
+         *  system and attempts to back it with huge pages, which drastically
+         *  reduces TLB misses when walking large arrays.  The following are
+         *  tried, in order, until one works:
+         *  - EXPLICIT : Reserved huge pages (MAP_HUGETLB / MEM_LARGE_PAGES)
+         *  - TRANSPARENT : Normal pages with a transparent huge page hint
+         *    (madvise(MADV_HUGEPAGE))
+         *  - NORMAL : Plain old pages.
+         *
+         *  The size requested is rounded up to a multiple of the huge page
+         *  size.  If prefaulting is requested every page is touched up front
+         *  so the first real use of the store doesn't take any page faults.
+         *
+         *  If no memory could be acquired at all, the store is created with a
+         *  SIZE of zero and a nullptr storage pointer.
+         */
+        class HugePageStore : public IStore {
+
+            public:
+                //! The kinds of pages that may be backing the store.
+                enum PageKind {
+                    EXPLICIT,
+                    TRANSPARENT,
+                    NORMAL
+                };
+
+                //! Creates a store of (at least) a single huge page.
+                HugePageStore();
+                //! Creates a store of (at least) the provided size, optionally
+                //! faulting in every page immediately.
+                explicit HugePageStore(size_t, bool = false);
+                ~HugePageStore();
+
+                //! No copying or moving.  (The mapping is unique.)
+                HugePageStore(const HugePageStore&) = delete;
+                HugePageStore& operator=(const HugePageStore&) = delete;
+                HugePageStore(HugePageStore&&) = delete;
+                HugePageStore& operator=(HugePageStore&&) = delete;
+
+                //! @see "memory/store/IStore.h"
+                uint8_t* getRawStorage() override final;
+
+                //! Returns the kind of pages that ended up backing the store.
+                inline PageKind getPageKind() const { return _kind; }
+
+            private:
+                //! The result of asking the OS for memory.
+                struct Mapping {
+                    uint8_t* region;
+                    size_t size;
+                    PageKind kind;
+                };
+
+                //! Finishes construction once the memory has been acquired.
+                explicit HugePageStore(const Mapping&);
+
+                //! The memory backing the store.
+                uint8_t* _region;
+                //! The kind of pages backing the store.
+                PageKind _kind;
+
+                //! Acquires memory from the OS.
+                static Mapping map(size_t, bool);
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_HUGE_PAGE_STORE_H
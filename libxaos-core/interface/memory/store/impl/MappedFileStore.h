@@ -0,0 +1,95 @@
+#ifndef     LIBXAOS_CORE_MEMORY_MAPPED_FILE_STORE_H
+#define     LIBXAOS_CORE_MEMORY_MAPPED_FILE_STORE_H
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A MappedFileStore exposes the contents of a file as a store.
+         *
+         *  A MappedFileStore maps a file into the address space so its
+         *  contents can be used in place; nothing is read or copied up
+         *  front.  Pages are faulted in from the file (or the page cache) as
+         *  they're touched.  This is ideal for prebaked data (i.e. string
+         *  pools or asset blobs) that can be used as-is.
+         *
+         *  The file may be mapped:
+         *  - READ_ONLY : Writing to the store will crash the process.
+         *  - COPY_ON_WRITE : Writes are allowed but are private to this
+         *    store; the file is never modified.
+         *
+         *  The kernel can be told how the store will be accessed (see
+         *  advise()) and asked to start reading pages in ahead of their use
+         *  (see prefetch()).  Both are only hints.
+         *
+         *  SIZE is the size of the file.  If the file can't be opened or
+         *  mapped (or is empty), the store is created with a SIZE of zero
+         *  and a nullptr storage pointer.
+         */
+        class MappedFileStore : public IStore {
+
+            public:
+                //! How the file is mapped.
+                enum Mode {
+                    READ_ONLY,
+                    COPY_ON_WRITE
+                };
+                //! How the store is expected to be accessed.
+                enum Access {
+                    NORMAL,
+                    SEQUENTIAL,
+                    RANDOM
+                };
+
+                //! Maps the file at the provided path with the provided mode
+                //! and access pattern.  Optionally prefetches the whole file.
+                explicit MappedFileStore(const char*, Mode = READ_ONLY,
+                        Access = NORMAL, bool = false);
+                ~MappedFileStore();
+
+                //! No copying or moving.  (The mapping is unique.)
+                MappedFileStore(const MappedFileStore&) = delete;
+                MappedFileStore& operator=(const MappedFileStore&) = delete;
+                MappedFileStore(MappedFileStore&&) = delete;
+                MappedFileStore& operator=(MappedFileStore&&) = delete;
+
+                //! @see "memory/store/IStore.h"
+                uint8_t* getRawStorage() override final;
+
+                //! Hints how the whole store will be accessed from now on.
+                void advise(Access);
+                //! Asks the kernel to start reading in the provided range
+                //! (offset, size) now.  Returns immediately.
+                void prefetch(size_t, size_t);
+
+                //! Returns how the file was mapped.
+                inline Mode getMode() const { return _mode; }
+
+            private:
+                //! The result of asking the OS for a mapping.
+                struct Mapping {
+                    uint8_t* region;
+                    size_t size;
+                };
+
+                //! Finishes construction once the file has been mapped.
+                MappedFileStore(const Mapping&, Mode, Access, bool);
+
+                //! The mapped file.
+                uint8_t* _region;
+                //! How the file was mapped.
+                Mode _mode;
+
+                //! Maps a file.
+                static Mapping map(const char*, Mode);
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_MAPPED_FILE_STORE_H
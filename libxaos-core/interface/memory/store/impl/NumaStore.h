@@ -0,0 +1,82 @@
+#ifndef     LIBXAOS_CORE_MEMORY_NUMA_STORE_H
+#define     LIBXAOS_CORE_MEMORY_NUMA_STORE_H
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A NumaStore backs its data with memory on a particular NUMA
+         *  node.
+         *
+         *  A NumaStore acquires its memory directly from the operating system
+         *  and binds it to a node before it's touched, so threads running on
+         *  that node never pay cross-socket latency to reach it.  Pair it
+         *  with NumaPools to give each node its own allocator.
+         *
+         *  If the requested node doesn't exist (i.e. on a single node
+         *  machine) node zero is used instead.  If binding fails the memory
+         *  is still usable, just placed wherever the OS likes; isBound()
+         *  reports which happened.
+         *
+         *  The size requested is rounded up to a multiple of the page size.
+         *  If prefaulting is requested every page is touched up front (after
+         *  binding, so the pages land on the right node).
+         *
+         *  If no memory could be acquired at all, the store is created with a
+         *  SIZE of zero and a nullptr storage pointer.
+         */
+        class NumaStore : public IStore {
+
+            public:
+                //! Creates a store of (at least) the provided size on the
+                //! provided node, optionally faulting in every page
+                //! immediately.
+                NumaStore(size_t, size_t, bool = false);
+                ~NumaStore();
+
+                //! No copying or moving.  (The mapping is unique.)
+                NumaStore(const NumaStore&) = delete;
+                NumaStore& operator=(const NumaStore&) = delete;
+                NumaStore(NumaStore&&) = delete;
+                NumaStore& operator=(NumaStore&&) = delete;
+
+                //! @see "memory/store/IStore.h"
+                uint8_t* getRawStorage() override final;
+
+                //! Returns the node the memory was placed on.
+                inline size_t getNode() const { return _node; }
+                //! Returns true if the memory was actually bound to the node.
+                inline bool isBound() const { return _bound; }
+
+            private:
+                //! The result of asking the OS for memory.
+                struct Mapping {
+                    uint8_t* region;
+                    size_t size;
+                    size_t node;
+                    bool bound;
+                };
+
+                //! Finishes construction once the memory has been acquired.
+                explicit NumaStore(const Mapping&);
+
+                //! The memory backing the store.
+                uint8_t* _region;
+                //! The node the memory was placed on.
+                size_t _node;
+                //! Whether the memory was bound to the node.
+                bool _bound;
+
+                //! Acquires memory from the OS.
+                static Mapping map(size_t, size_t, bool);
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_NUMA_STORE_H
@@ -17,9 +17,9 @@ namespace libxaos {
          */
         template<size_t N, short A, int ID>
         #ifdef _MSC_VER // GODDAMIT MICROSOFT....  FOLLOW THE STANDARD...
-            uint8_t StaticStore<N, A, ID>::_store[] = "";
+            alignas(A) uint8_t StaticStore<N, A, ID>::_store[] = "";
         #else
-            uint8_t StaticStore<N, A, ID>::_store[] {};
+            alignas(A) uint8_t StaticStore<N, A, ID>::_store[] {};
         #endif
 
         template<size_t N, short A, int ID>
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include "memory/store/IStore.h"
+#include "memory/utility/alignment.h"
 
 namespace libxaos {
     namespace memory {
@@ -21,12 +22,17 @@ namespace libxaos {
          *  which forces the compiler to create an entirely new class for each
          *  ID.  This allows each class to have its own static array of data.
          *
+         *  The store's data is guaranteed to begin on an A byte boundary.  (A
+         *  must be a power of two.)
+         *
          *  @tparam N the size_t of bytes this store contains.
          *  @tparam A the short at which the data should be internally aligned.
          *  @tparam ID the integer uniquely identifying this static allocation.
          */
         template<size_t N, short A, int ID> //! @todo reserve negative IDs
         class StaticStore : public IStore {
+            static_assert(isPowerOfTwo(A),
+                    "A StaticStore's alignment must be a power of two!");
 
             public:
                 StaticStore();
@@ -41,7 +47,8 @@ namespace libxaos {
                 static constexpr const int STORE_ID = ID;
 
             private:
-                static uint8_t _store[N]; //!< The Store's static memory.
+                //! The Store's static memory.
+                alignas(A) static uint8_t _store[N];
         };
 
     }
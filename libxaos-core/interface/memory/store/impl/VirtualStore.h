@@ -0,0 +1,90 @@
+#ifndef     LIBXAOS_CORE_MEMORY_VIRTUAL_STORE_H
+#define     LIBXAOS_CORE_MEMORY_VIRTUAL_STORE_H
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "memory/store/IStore.h"
+
+namespace libxaos {
+    namespace memory {
+
+        /**
+         *  @brief A VirtualStore reserves address space up front and backs it
+         *  with memory on demand.
+         *
+         *  A VirtualStore reserves a (potentially very large) range of virtual
+         *  addresses when it's created, but doesn't back any of it with actual
+         *  memory.  Pages are committed as the user's high-water mark rises
+         *  (see IStore::commit()), so the process only pays for the memory it
+         *  has actually touched.
+         *
+         *  Because the whole range is reserved at once, getRawStorage() never
+         *  changes.  Anything pointing into the store (PooledStrings, for
+         *  instance) remains valid no matter how far the store grows.
+         *
+         *  Commits are rounded up to at least the growth granularity provided
+         *  at construction to keep the number of system calls down.
+         *
+         *  If the address space can't be reserved, the store is created with
+         *  a SIZE of zero and a nullptr storage pointer.
+         *
+         *  This class is NOT thread safe.
+         */
+        class VirtualStore : public IStore {
+
+            public:
+                //! The number of bytes reserved when one isn't specified.
+                static constexpr const size_t DEFAULT_RESERVE =
+                        sizeof(void*) >= 8 ? size_t(1) << 30 : size_t(1) << 26;
+                //! The minimum number of bytes committed at a time.
+                static constexpr const size_t DEFAULT_GROWTH = 64 * 1024;
+
+                VirtualStore();
+                //! Reserve the provided number of bytes and commit them in
+                //! chunks of (at least) the provided growth.
+                explicit VirtualStore(size_t, size_t = DEFAULT_GROWTH);
+                ~VirtualStore();
+
+                //! No copying or moving.  (The reserved range is unique.)
+                VirtualStore(const VirtualStore&) = delete;
+                VirtualStore& operator=(const VirtualStore&) = delete;
+                VirtualStore(VirtualStore&&) = delete;
+                VirtualStore& operator=(VirtualStore&&) = delete;
+
+                //! @see "memory/store/IStore.h"
+                uint8_t* getRawStorage() override final;
+                //! @see "memory/store/IStore.h"
+                bool commit(size_t) override final;
+                //! @see "memory/store/IStore.h"
+                size_t getCommitted() const override final;
+
+                /**
+                 *  @brief Returns all committed memory to the operating
+                 *  system.
+                 *
+                 *  The address range stays reserved (and getRawStorage()
+                 *  remains the same) but all data is lost.
+                 *
+                 *  Never decommit a store an allocator (or string pool) owns.
+                 *  They cache how much is committed when they take the store
+                 *  and would keep handing out the now inaccessible memory.
+                 */
+                void decommit();
+
+            private:
+                //! Finishes construction once the range has been reserved.
+                VirtualStore(uint8_t*, size_t, size_t);
+
+                //! The reserved address range.
+                uint8_t* _region;
+                //! The number of bytes currently committed.
+                size_t _committed;
+                //! The minimum number of bytes committed at a time.
+                size_t _growth;
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_VIRTUAL_STORE_H
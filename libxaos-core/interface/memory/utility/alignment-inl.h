@@ -0,0 +1,51 @@
+/**
+ *  @file alignment-inl.h
+ *  @brief Inline Implements for: libxaos-core:memory/utility/alignment.h
+ *
+ *  This file provides inline implementations for the alignment helpers.
+ */
+
+#include <cassert>
+
+namespace libxaos {
+    namespace memory {
+
+        // Size Helpers (C++11 constexpr... one return statement each. :P )
+        constexpr bool isPowerOfTwo(size_t value) {
+            return value != 0 && (value & (value - 1)) == 0;
+        }
+        constexpr size_t alignUp(size_t value, size_t alignment) {
+            return (value + (alignment - 1)) & ~(alignment - 1);
+        }
+        constexpr size_t alignDown(size_t value, size_t alignment) {
+            return value & ~(alignment - 1);
+        }
+        constexpr bool isAligned(size_t value, size_t alignment) {
+            return (value & (alignment - 1)) == 0;
+        }
+
+        // Pointer Helpers
+        template<typename T>
+        inline T* alignUp(T* pointer, size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+            return reinterpret_cast<T*>(alignUp(
+                    reinterpret_cast<uintptr_t>(pointer), alignment));
+        }
+        template<typename T>
+        inline T* alignDown(T* pointer, size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+            return reinterpret_cast<T*>(alignDown(
+                    reinterpret_cast<uintptr_t>(pointer), alignment));
+        }
+        inline bool isAligned(const void* pointer, size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+            return isAligned(reinterpret_cast<uintptr_t>(pointer), alignment);
+        }
+        inline size_t getAlignmentOffset(const void* pointer,
+                size_t alignment) {
+            assert(isPowerOfTwo(alignment));
+            uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+            return alignUp(address, alignment) - address;
+        }
+    }
+}
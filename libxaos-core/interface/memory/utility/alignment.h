@@ -1 +1,73 @@
+/**
+ *  @file alignment.h
+ *  @brief Memory Alignment Utilities
+ *
+ *  This file contains constants and helper functions for aligning sizes,
+ *  offsets, and pointers.  All alignments passed to these functions MUST be
+ *  powers of two (see isPowerOfTwo).
+ *
+ *  The following constants are provided:
+ *  - CACHE_LINE_SIZE : The size of a cache line on the compiling CPU.
+ *  - SIMD_ALIGNMENT : The alignment required by the widest SIMD register the
+ *    compiling CPU is targeting (i.e. __m128 vs __m256).
+ *
+ *  The size-based helpers are constexpr so they may be used in template
+ *  arguments and static_asserts.
+ */
 
+#ifndef     LIBXAOS_CORE_MEMORY_UTILITY_ALIGNMENT_H
+#define     LIBXAOS_CORE_MEMORY_UTILITY_ALIGNMENT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "utility/cpu.h"
+
+namespace libxaos {
+    namespace memory {
+
+        //! The size, in bytes, of a cache line.
+        #if defined(LIBXAOS_FLAG_CPU_POWERPC)
+            constexpr const size_t CACHE_LINE_SIZE = 128;
+        #else
+            constexpr const size_t CACHE_LINE_SIZE = 64;
+        #endif
+
+        //! The alignment, in bytes, required by the widest SIMD registers.
+        #if defined(__AVX512F__)
+            constexpr const size_t SIMD_ALIGNMENT = 64;
+        #elif defined(__AVX__)
+            constexpr const size_t SIMD_ALIGNMENT = 32;
+        #else
+            constexpr const size_t SIMD_ALIGNMENT = 16;
+        #endif
+
+        //! Determines if the provided value is a (non-zero) power of two.
+        constexpr bool isPowerOfTwo(size_t);
+
+        //! Rounds a size up to the next multiple of alignment.
+        constexpr size_t alignUp(size_t, size_t);
+        //! Rounds a size down to the previous multiple of alignment.
+        constexpr size_t alignDown(size_t, size_t);
+        //! Determines if a size is a multiple of alignment.
+        constexpr bool isAligned(size_t, size_t);
+
+        //! Rounds a pointer up to the next aligned address.
+        template<typename T>
+        inline T* alignUp(T*, size_t);
+        //! Rounds a pointer down to the previous aligned address.
+        template<typename T>
+        inline T* alignDown(T*, size_t);
+        //! Determines if a pointer is aligned.
+        inline bool isAligned(const void*, size_t);
+
+        //! Returns the number of bytes that must be skipped from the pointer
+        //! to reach an aligned address.
+        inline size_t getAlignmentOffset(const void*, size_t);
+    }
+}
+
+// Pull in implementations
+#include "memory/utility/alignment-inl.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_UTILITY_ALIGNMENT_H
@@ -0,0 +1,61 @@
+/**
+ *  @file bulk.h
+ *  @brief Bulk Memory Kernels
+ *
+ *  This file contains copy, fill, zero and compare routines for moving large
+ *  amounts of memory (i.e. restoring a snapshot into a store or clearing a
+ *  big buffer) without evicting everything else from the cache.
+ *
+ *  Below STREAMING_THRESHOLD bytes they're plain memcpy/memset/memcmp, which
+ *  are hard to beat for small sizes and leave the data in the cache (where
+ *  it's likely wanted).  At or above it, on Intel CPUs:
+ *  - copy, fill and zero use non-temporal (streaming) stores, which write
+ *    around the cache.  AVX is used if the CPU has it, SSE2 otherwise.
+ *  - compare prefetches with a non-temporal hint so the data it walks is
+ *    the first to be evicted.
+ *
+ *  Streamed data is NOT in the cache afterwards, so don't use these for
+ *  memory that's about to be read again.  The stores are fenced before
+ *  returning; the data is visible to other threads like any other write.
+ *
+ *  Other CPUs always use the plain routines.
+ */
+
+#ifndef     LIBXAOS_CORE_MEMORY_UTILITY_BULK_H
+#define     LIBXAOS_CORE_MEMORY_UTILITY_BULK_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace libxaos {
+    namespace memory {
+
+        //! Sizes at or above this use the streaming kernels.  (Roughly where
+        //! a copy starts pushing useful data out of the L2.)
+        constexpr const size_t STREAMING_THRESHOLD = 256 * 1024;
+
+        //! The kernels that large operations may be handed to.
+        enum BulkKernel {
+            BULK_KERNEL_PLAIN,
+            BULK_KERNEL_SSE2,
+            BULK_KERNEL_AVX
+        };
+
+        //! Returns the kernel this CPU uses for large operations.
+        BulkKernel getBulkKernel();
+
+        //! Copies size bytes from source to destination.  (The ranges may
+        //! NOT overlap.)
+        void bulkCopy(void*, const void*, size_t);
+        //! Sets size bytes at destination to value.
+        void bulkFill(void*, uint8_t, size_t);
+        //! Sets size bytes at destination to zero.
+        void bulkZero(void*, size_t);
+        //! Compares size bytes.  Returns less than, equal to or greater than
+        //! zero like memcmp.
+        int bulkCompare(const void*, const void*, size_t);
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_UTILITY_BULK_H
@@ -0,0 +1,43 @@
+/**
+ *  @file numa.h
+ *  @brief NUMA Topology Utilities
+ *
+ *  This file contains helpers for querying which NUMA node the calling thread
+ *  is running on and for placing memory on a particular node.  They talk to
+ *  the kernel directly (no libnuma required).
+ *
+ *  Machines (or kernels) without NUMA support look like a single node:  the
+ *  node count is one, every thread is on node zero and binding memory simply
+ *  fails (which is harmless; the memory is still usable).
+ */
+
+#ifndef     LIBXAOS_CORE_MEMORY_UTILITY_NUMA_H
+#define     LIBXAOS_CORE_MEMORY_UTILITY_NUMA_H
+
+#include <cstddef>
+
+namespace libxaos {
+    namespace memory {
+
+        //! The most NUMA nodes that will be reported.
+        constexpr size_t MAX_NUMA_NODES = 64;
+
+        //! Returns the number of NUMA nodes (at least one).
+        size_t getNumaNodeCount();
+        //! Returns the NUMA node the calling thread is currently running on.
+        //! (Threads may migrate; treat this as a hint.)
+        size_t getCurrentNumaNode();
+
+        //! Binds a page aligned range (pointer, size) of memory to a node.
+        //! Pages already touched are migrated.  Returns false if the memory
+        //! couldn't be bound.
+        bool bindToNumaNode(void*, size_t, size_t);
+        //! Asks for the calling thread's future allocations to be placed on
+        //! the provided node where possible.  Returns false if the request
+        //! couldn't be made.
+        bool setPreferredNumaNode(size_t);
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_UTILITY_NUMA_H
@@ -0,0 +1,36 @@
+/**
+ *  @file pages.h
+ *  @brief Virtual Memory Page Utilities
+ *
+ *  This file contains helpers for querying the operating system's virtual
+ *  memory page configuration.  Stores that talk to the operating system
+ *  directly (rather than using static memory) should size and align their
+ *  requests with these values.
+ */
+
+#ifndef     LIBXAOS_CORE_MEMORY_UTILITY_PAGES_H
+#define     LIBXAOS_CORE_MEMORY_UTILITY_PAGES_H
+
+#include <cstddef>
+
+namespace libxaos {
+    namespace memory {
+
+        //! Returns the size, in bytes, of a virtual memory page.
+        size_t getPageSize();
+        //! Returns the granularity, in bytes, at which address space may be
+        //! reserved.  (This is larger than the page size on Windows.)
+        size_t getReserveGranularity();
+        //! Returns the size, in bytes, of a huge (large) page.  This is the
+        //! system's default huge page size where it can be determined, or
+        //! 2MB otherwise.
+        size_t getHugePageSize();
+
+        //! Returns the page size clamped to the largest value an IStore can
+        //! report as its ALIGNMENT.
+        unsigned short getPageAlignment();
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_MEMORY_UTILITY_PAGES_H
@@ -0,0 +1,20 @@
+/**
+ *  @file tracking-inl.h
+ *  @brief Inline implements: libxaos-core:memory/utility/tracking.h
+ *
+ *  When tracking is compiled out, recording does nothing at all.
+ */
+
+#ifndef LIBXAOS_FLAG_MEMORY_TRACKING
+
+namespace libxaos {
+    namespace memory {
+
+        inline void recordAllocation(MemoryTag, size_t, size_t) {}
+        inline void recordDeallocation(MemoryTag, size_t, size_t) {}
+        inline void recordAllocationFailure(MemoryTag, size_t) {}
+
+    }
+}
+
+#endif   // LIBXAOS_FLAG_MEMORY_TRACKING
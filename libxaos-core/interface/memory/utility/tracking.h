@@ -0,0 +1,119 @@
+/**
+ *  @file tracking.h
+ *  @brief Tagged Allocation Tracking
+ *
+ *  This file contains the instrumentation libxaos allocators report to.  Every
+ *  allocator (and StringPool) carries a MemoryTag naming the subsystem it
+ *  serves.  For each tag the following are recorded:
+ *  - live bytes, and the peak number of live bytes
+ *  - allocation, deallocation, and failed allocation counts
+ *  - the number of allocations (and bytes) made during the last frame
+ *  - an optional budget, which the peak can be checked against
+ *
+ *  Frames are delimited by calling tickMemoryFrame() (i.e. right alongside
+ *  Stopwatch::tick() in the main loop).
+ *
+ *  Tracking is compiled out unless the following flag is defined:
+ *  - LIBXAOS_FLAG_MEMORY_TRACKING : Record allocations per MemoryTag.
+ *
+ *  When it isn't defined the record functions are empty inlines, so tagged
+ *  code costs nothing.  Tags may still be registered and queried; their
+ *  statistics simply remain zero.  (MEMORY_TRACKING_ENABLED reports which.)
+ *
+ *  The flag MUST have the same value in libxaos-core and everything that
+ *  includes this file.  A mismatch silently drops records (the inline
+ *  record functions are empty on one side) or violates the one definition
+ *  rule.  The Debug targets define it.
+ *
+ *  Recording is thread safe.
+ */
+
+#ifndef     LIBXAOS_CORE_MEMORY_UTILITY_TRACKING_H
+#define     LIBXAOS_CORE_MEMORY_UTILITY_TRACKING_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace libxaos {
+    namespace memory {
+
+        //! True if allocations are being recorded.
+        #ifdef LIBXAOS_FLAG_MEMORY_TRACKING
+            constexpr bool MEMORY_TRACKING_ENABLED = true;
+        #else
+            constexpr bool MEMORY_TRACKING_ENABLED = false;
+        #endif
+
+        //! Identifies the subsystem an allocation belongs to.
+        using MemoryTag = uint8_t;
+
+        //! The tag every allocator starts with.
+        constexpr MemoryTag MEMORY_TAG_UNTAGGED = 0;
+        //! The number of tags that may exist (including MEMORY_TAG_UNTAGGED).
+        constexpr size_t MAX_MEMORY_TAGS = 64;
+
+        //! A snapshot of a single tag's usage.
+        struct MemoryTagStatistics {
+            //! The name the tag was registered with.
+            const char* name;
+            //! Bytes currently allocated.
+            size_t liveBytes;
+            //! The most bytes that have ever been allocated at once.
+            size_t peakBytes;
+            //! The number of successful allocations.
+            size_t allocationCount;
+            //! The number of deallocations.
+            size_t deallocationCount;
+            //! The number of allocations that returned nullptr.
+            size_t failureCount;
+            //! Allocations made during the last complete frame.
+            size_t frameAllocationCount;
+            //! Bytes allocated during the last complete frame.
+            size_t frameAllocatedBytes;
+            //! The budget set for this tag (zero if none).
+            size_t budget;
+            //! True if the peak has ever exceeded the budget.
+            bool overBudget;
+        };
+
+        /**
+         *  @brief Registers a new MemoryTag.
+         *
+         *  Returns the tag for the provided name, registering it first if it
+         *  is new.  The name must outlive the program (i.e. a literal).  If
+         *  every tag is taken MEMORY_TAG_UNTAGGED is returned.
+         */
+        MemoryTag registerMemoryTag(const char*);
+        //! Returns the number of tags registered (including
+        //! MEMORY_TAG_UNTAGGED).  Tags are numbered from zero.
+        size_t getMemoryTagCount();
+        //! Sets the number of bytes a tag is expected to stay within.
+        void setMemoryBudget(MemoryTag, size_t);
+        //! Returns a snapshot of a tag's usage.
+        MemoryTagStatistics getMemoryTagStatistics(MemoryTag);
+
+        //! Ends the current frame (for the per-frame counters).
+        void tickMemoryFrame();
+
+        #ifdef LIBXAOS_FLAG_MEMORY_TRACKING
+            //! Records bytes being allocated.  (Counts default to one; pass
+            //! zero when an existing allocation grows.)
+            void recordAllocation(MemoryTag, size_t, size_t = 1);
+            //! Records bytes being freed.  (Counts default to one; pass zero
+            //! when an allocation shrinks or an arena rewinds.)
+            void recordDeallocation(MemoryTag, size_t, size_t = 1);
+            //! Records an allocation of the provided size failing.
+            void recordAllocationFailure(MemoryTag, size_t);
+        #else
+            inline void recordAllocation(MemoryTag, size_t, size_t = 1);
+            inline void recordDeallocation(MemoryTag, size_t, size_t = 1);
+            inline void recordAllocationFailure(MemoryTag, size_t);
+        #endif
+
+    }
+}
+
+// Pull in the (empty) inline implementations
+#include "memory/utility/tracking-inl.h"
+
+#endif   // LIBXAOS_CORE_MEMORY_UTILITY_TRACKING_H
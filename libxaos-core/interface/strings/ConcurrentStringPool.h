@@ -0,0 +1,143 @@
+#ifndef     LIBXAOS_CORE_STRINGS_CONCURRENT_STRING_POOL_H
+#define     LIBXAOS_CORE_STRINGS_CONCURRENT_STRING_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "memory/utility/tracking.h"
+#include "strings/HashedString.h"
+
+namespace libxaos {
+
+    // Forward Declare IStore
+    namespace memory {
+        class IStore;
+    }
+
+    namespace strings {
+
+        // Forward Declare PooledString
+        class PooledString;
+
+        /**
+         *  @brief A StringPool that may be shared between threads.
+         *
+         *  A ConcurrentStringPool holds strings just like a StringPool (with
+         *  the same limits on their length) but any number of threads may
+         *  process() and query it at once.  However many threads add the same
+         *  string, they all get back the same PooledString.
+         *
+         *  The index is split into SHARD_COUNT shards (chosen by hash), each
+         *  with its own lock, so threads only wait on each other when adding
+         *  strings to the same shard.  Finding a string that's already pooled
+         *  (which is what most calls do) takes no lock at all.  Strings are
+         *  appended to the store with a compare-and-swap.
+         *
+         *  Since lookups don't lock, the index can't be rebuilt; its size is
+         *  fixed by the index store (which is committed and cleared up
+         *  front).  Once a shard is three quarters full, new strings that
+         *  hash to it are refused, just as if the string store were full.
+         */
+        class ConcurrentStringPool {
+
+            public:
+                //! The number of independently locked shards.
+                static constexpr const size_t SHARD_COUNT = 16;
+                //! The size of the index store when one isn't provided.
+                static constexpr const size_t DEFAULT_INDEX_RESERVE =
+                        sizeof(void*) >= 8 ? size_t(1) << 24 : size_t(1) << 20;
+
+                //! An IStore is required to store strings in memory.  Another
+                //! may be provided for the index (otherwise a VirtualStore of
+                //! DEFAULT_INDEX_RESERVE is used, and only its pages that
+                //! are probed are ever touched).  A provided index store is
+                //! cleared.  (Acquires ownership of both.)
+                ConcurrentStringPool(memory::IStore*,
+                        memory::IStore* = nullptr);
+                ~ConcurrentStringPool();
+
+                //! No copying or moving!  (Other threads may be using it.)
+                ConcurrentStringPool(const ConcurrentStringPool&) = delete;
+                ConcurrentStringPool& operator=(const ConcurrentStringPool&) =
+                        delete;
+                ConcurrentStringPool(ConcurrentStringPool&&) = delete;
+                ConcurrentStringPool& operator=(ConcurrentStringPool&&) =
+                        delete;
+
+                //! Add / Get a String to the Pool
+                PooledString process(const char*);
+                //! Query if a String is present (const char*)
+                bool contains(const char*) const;
+                //! Query if a String is present (PooledString)
+                bool contains(const PooledString&) const;
+
+                //! Returns the number of strings in the pool.
+                size_t getCount() const;
+
+                //! Sets the tag added strings are recorded under.  (Set it
+                //! before sharing the pool.)
+                void setMemoryTag(memory::MemoryTag);
+                //! Returns the tag added strings are recorded under.
+                memory::MemoryTag getMemoryTag() const;
+
+            private:
+                //! An entry in the index.  The offset is published last; a
+                //! zero offset marks the slot empty.
+                struct IndexSlot {
+                    //! One past where the string's characters start.
+                    std::atomic<size_t> offset;
+                    //! The string's hash.
+                    std::atomic<HashType> hash;
+                };
+                //! A slice of the index and the lock for adding to it.
+                struct Shard {
+                    Shard() : mutex(), slots(nullptr), count(0) {}
+
+                    //! Held while adding to this shard.
+                    std::mutex mutex;
+                    //! This shard's slots.
+                    IndexSlot* slots;
+                    //! The number of strings in this shard.
+                    std::atomic<size_t> count;
+                };
+
+                //! Returns the shard a hash belongs to.
+                Shard& getShard(HashType) const;
+                //! Finds the slot holding a string of the provided length and
+                //! hash (or the empty slot it would go in).  Returns nullptr
+                //! if there's no index.  (A full shard would probe forever;
+                //! process() never fills a shard past 3/4.)
+                IndexSlot* findSlot(const Shard&, const char*, size_t,
+                        HashType) const;
+                //! Reserves room for a string at the end of the store.
+                //! Returns its offset (or SIZE_MAX if there's no room).
+                size_t append(size_t);
+
+                //! Where we will store our strings
+                //! @todo Replace with UniquePointer (when implemented)
+                memory::IStore* _store;
+                //! Where we keep the index.
+                //! @todo Replace with UniquePointer (when implemented)
+                memory::IStore* _indexStore;
+                //! Cached pointer to the beginning of the string store.
+                uint8_t* _begin;
+                //! The number of bytes used in _store.
+                std::atomic<size_t> _used;
+                //! The number of bytes _store has backed.
+                std::atomic<size_t> _committed;
+                //! Held while committing more of _store.
+                std::mutex _commitMutex;
+                //! The shards of the index.
+                mutable Shard _shards[SHARD_COUNT];
+                //! The number of slots in each shard (a power of two).
+                size_t _slotCount;
+                //! The tag added strings are recorded under.
+                memory::MemoryTag _tag;
+        };
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_STRINGS_CONCURRENT_STRING_POOL_H
@@ -3,29 +3,67 @@
  *  @brief Inline implements: libxaos-core:strings/HashedString.h
  *
  *  This file provides inline implementations for the HashedString class.
+ *
+ *  C++11 constexpr functions are a single return statement, so the hash is
+ *  written recursively here.  It MUST stay in step with hashString() in
+ *  HashedString.cpp (the tests compare them).
  */
 
 namespace libxaos {
     namespace strings {
 
-        inline bool operator==(const HashedString& a, const HashedString& b) {
+        // Compile-time Hashing
+        constexpr HashedString::HashedString(HashType hash, std::nullptr_t) :
+                _hash(hash) {}
+        constexpr HashType HashedString::hash(const char* str) {
+            return str == nullptr ? NULL_STRING_HASH :
+                    str[0] == '\0' ? EMPTY_STRING_HASH :
+                    remapHash(hashCharacters(str, HASH_SEED));
+        }
+        constexpr HashType HashedString::hashCharacters(const char* str,
+                HashType hash) {
+            #ifdef LIBXAOS_FLAG_WIDE_HASHES
+                return str[0] == '\0' ? hash : hashCharacters(str + 1,
+                        static_cast<HashType>((hash ^
+                        static_cast<unsigned char>(str[0])) *
+                        HASH_MULTIPLIER));
+            #else
+                return str[0] == '\0' ? hash : hashCharacters(str + 1,
+                        static_cast<HashType>(hash * HASH_MULTIPLIER +
+                        static_cast<unsigned char>(str[0])));
+            #endif
+        }
+        constexpr HashType HashedString::remapHash(HashType hash) {
+            return hash == NULL_STRING_HASH ? hash - 1 :
+                    hash == EMPTY_STRING_HASH ? hash + 1 : hash;
+        }
+
+        constexpr bool operator==(const HashedString& a,
+                const HashedString& b) {
             return a.getHash() == b.getHash();
         }
-        inline bool operator!=(const HashedString& a, const HashedString& b) {
+        constexpr bool operator!=(const HashedString& a,
+                const HashedString& b) {
             return !(a == b);
         }
-        inline bool operator==(const HashedString& string, HashType hash) {
+        constexpr bool operator==(const HashedString& string, HashType hash) {
             return string.getHash() == hash;
         }
-        inline bool operator==(HashType hash, HashedString& string) {
+        constexpr bool operator==(HashType hash, const HashedString& string) {
             return string == hash;
         }
-        inline bool operator!=(const HashedString& string, HashType hash) {
+        constexpr bool operator!=(const HashedString& string, HashType hash) {
             return !(string == hash);
         }
-        inline bool operator!=(HashType hash, const HashedString& string) {
+        constexpr bool operator!=(HashType hash, const HashedString& string) {
             return string != hash;
         }
 
+        namespace literals {
+            constexpr HashedString operator"" _hs(const char* str, size_t) {
+                return HashedString {HashedString::hash(str), nullptr};
+            }
+        }
+
     }
 }
@@ -1,7 +1,9 @@
 #ifndef     LIBXAOS_CORE_STRINGS_HASHED_STRING_H
 #define     LIBXAOS_CORE_STRINGS_HASHED_STRING_H
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string>
 
 namespace libxaos {
@@ -9,9 +11,22 @@ namespace libxaos {
 
         // Forward declare PooledString
         class PooledString;
+        // Forward declare HashedString (for the literal)
+        class HashedString;
 
-        //! The number used in the hashing.
-        using HashType = uint32_t;
+        namespace literals {
+            //! Hashes a string literal at compile time.
+            constexpr HashedString operator"" _hs(const char*, size_t);
+        }
+
+        //! The number used in the hashing.  (Defining
+        //! LIBXAOS_FLAG_WIDE_HASHES makes it 64 bits and switches from djb2
+        //! to FNV-1a: four more bytes per hash for far fewer collisions.)
+        #ifdef LIBXAOS_FLAG_WIDE_HASHES
+            using HashType = uint64_t;
+        #else
+            using HashType = uint32_t;
+        #endif
 
         /**
          *  @brief Represents a mechaism for converting strings into hashes.
@@ -25,6 +40,24 @@ namespace libxaos {
          *  the empty string.  In the event that a non-empty string resolves
          *  to one of these hardcoded values, it is shifted slightly away from
          *  the value to a valid hash code.
+         *
+         *  The hash is djb2 (hash * 33 + c) by default.  djb2 is quick and
+         *  stable (_hs values, switch labels and pool images depend on it),
+         *  but its structure collides easily: raising one character by one
+         *  and lowering the next by 33 never changes the hash.  Wide hashes
+         *  use FNV-1a-64 ((hash ^ c) * prime) instead, which doesn't.
+         *
+         *  Hashes of literals can be computed at compile time, either with
+         *  hash() or the _hs literal (see strings::literals), which produce
+         *  exactly what the runtime constructors do:
+         *
+         *      using namespace libxaos::strings::literals;
+         *      switch (event.getHash()) {
+         *          case "jump"_hs.getHash(): ...
+         *      }
+         *
+         *  (The compile-time hash recurses once per character, so very long
+         *  literals may hit the compiler's constexpr depth limit.)
          */
         class HashedString {
 
@@ -32,24 +65,44 @@ namespace libxaos {
 
                 //! Construct a HashedString from a character literal
                 explicit HashedString(const char*);
+                //! Construct a HashedString from a string of known length
+                //! (saves measuring it)
+                HashedString(const char*, size_t);
                 //! Construct a HashedString from a std::string (convenience)
                 explicit HashedString(const std::string&);
                 //! Cosntruct a HashedString from a PooledString
                 explicit HashedString(const PooledString&);
-                ~HashedString();
+                ~HashedString() = default;
 
-                HashedString(const HashedString&);
-                HashedString& operator=(const HashedString&);
-                HashedString(HashedString&&);
-                HashedString& operator=(HashedString&&);
+                HashedString(const HashedString&) = default;
+                HashedString& operator=(const HashedString&) = default;
+                HashedString(HashedString&&) = default;
+                HashedString& operator=(HashedString&&) = default;
 
                 //! Returns the hash of the string used in construction.
-                inline HashType getHash() const { return _hash; }
+                constexpr HashType getHash() const { return _hash; }
+
+                //! Hashes a string at compile time.  (Identical to the
+                //! runtime hash.)
+                static constexpr HashType hash(const char*);
+
+                //! The value every hash starts from and the number it's
+                //! multiplied by for each character.
+                #ifdef LIBXAOS_FLAG_WIDE_HASHES
+                    static constexpr const HashType HASH_SEED =
+                            14695981039346656037ULL;
+                    static constexpr const HashType HASH_MULTIPLIER =
+                            1099511628211ULL;
+                #else
+                    static constexpr const HashType HASH_SEED = 5381;
+                    static constexpr const HashType HASH_MULTIPLIER = 33;
+                #endif
 
                 //! Unique hash for nullptr strings
-                static const HashType NULL_STRING_HASH;
+                static constexpr const HashType NULL_STRING_HASH =
+                        std::numeric_limits<HashType>::max();
                 //! Unique hash for empty strings
-                static const HashType EMPTY_STRING_HASH;
+                static constexpr const HashType EMPTY_STRING_HASH = 0;
 
                 //! Uniquely identifies all nullptr strings
                 static const HashedString NULL_STRING;
@@ -57,22 +110,36 @@ namespace libxaos {
                 static const HashedString EMPTY_STRING;
 
             private:
+                //! Wraps a hash that has already been computed.  (Only
+                //! for the _hs literal.)
+                constexpr explicit HashedString(HashType, std::nullptr_t);
+
+                //! Continues the hash over the rest of a string.
+                static constexpr HashType hashCharacters(const char*,
+                        HashType);
+                //! Moves a hash off the reserved values.
+                static constexpr HashType remapHash(HashType);
+
                 //! This string's HashType / Value
                 HashType _hash;
+
+                //! The _hs literal wraps compile-time hashes.
+                friend constexpr HashedString literals::operator"" _hs(
+                        const char*, size_t);
         };
 
         //! Equality operator of two HashedStrings
-        inline bool operator==(const HashedString&, const HashedString&);
+        constexpr bool operator==(const HashedString&, const HashedString&);
         //! Inequality operator of two HashedStrings
-        inline bool operator!=(const HashedString&, const HashedString&);
+        constexpr bool operator!=(const HashedString&, const HashedString&);
         //! Equality operator of HashedString and HashType
-        inline bool operator==(const HashedString&, HashType);
+        constexpr bool operator==(const HashedString&, HashType);
         //! Equality operator of HashType and HashedString
-        inline bool operator==(HashType, const HashedString&);
+        constexpr bool operator==(HashType, const HashedString&);
         //! Inequality operator of HashedString and HashType
-        inline bool operator!=(const HashedString&, HashType);
+        constexpr bool operator!=(const HashedString&, HashType);
         //! Inequality operator of HashType and HashedString
-        inline bool operator!=(HashType, const HashedString&);
+        constexpr bool operator!=(HashType, const HashedString&);
     }
 }
 
@@ -5,6 +5,8 @@
  *  This file provides inline implementations for the PooledString class.
  */
 
+#include <cstring>
+
 namespace libxaos {
     namespace strings {
 
@@ -19,6 +21,28 @@ namespace libxaos {
             return _string;
         }
 
+        // Metadata - read out of the header in front of the string.  (With
+        // memcpy; the compiler turns it into plain loads.)
+        inline PooledString::Header PooledString::readHeader(
+                const char* str) {
+            Header header;
+            memcpy(&header, str - sizeof(Header), sizeof(Header));
+            return header;
+        }
+        inline size_t PooledString::length() const {
+            return _string ? readHeader(_string).length : 0;
+        }
+        inline HashType PooledString::getHash() const {
+            return _string ? readHeader(_string).hash :
+                    HashedString::NULL_STRING_HASH;
+        }
+        #if __cplusplus >= 201703L
+            inline std::string_view PooledString::getView() const {
+                return _string ? std::string_view {_string, length()} :
+                        std::string_view {};
+            }
+        #endif
+
         // Comparison operators - a lot of these depend on each other
         inline bool operator==(const PooledString& a, const PooledString& b) {
             return a.getCharPointer() == b.getCharPointer();
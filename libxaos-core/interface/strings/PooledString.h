@@ -2,25 +2,40 @@
 #define     LIBXAOS_CORE_STRINGS_POOLED_STRING_H
 
 #include <cstddef>
+#include <cstdint>
+
+#if __cplusplus >= 201703L
+    #include <string_view>
+#endif
+
+#include "strings/HashedString.h"
 
 namespace libxaos {
     namespace strings {
 
-        // Forward declare StringPool
+        // Forward declare the pools
         class StringPool;
+        class ConcurrentStringPool;
 
         /**
          *  @brief Represents a string in a StringPool.
          *
          *  Represents a pooled string in memory.  Does NOT allow user
-         *  construction and is only constructible by StringPool objects. This
-         *  is to ensure that no user can instantiate a PooledString from
-         *  nowhere.  (Though comparisons are allowed.)
+         *  construction and is only constructible by StringPool (and
+         *  ConcurrentStringPool) objects.  This is to ensure that no user can
+         *  instantiate a PooledString from nowhere.  (Though comparisons are
+         *  allowed.)
+         *
+         *  Every pooled string is stored with its length and hash, so
+         *  length(), getHash() and getView() are O(1).  A null PooledString
+         *  has a length of zero and the NULL_STRING_HASH.
          */
         class PooledString {
 
             //! The StringPool class needs to be a friend of the PooledString
             friend class StringPool;
+            //! As does the ConcurrentStringPool
+            friend class ConcurrentStringPool;
 
             public:
                 //! Allow direct construction of a nullptr string.
@@ -40,11 +55,40 @@ namespace libxaos {
 
                 //! Acquires the contents of this PooledString
                 inline const char* getCharPointer() const;
+                //! Returns the length of the string (excluding the null
+                //! character).
+                inline size_t length() const;
+                //! Returns the string's hash (as HashedString computes it).
+                inline HashType getHash() const;
+
+                #if __cplusplus >= 201703L
+                    //! Views the string (without its null character).
+                    inline std::string_view getView() const;
+                #endif
 
             private:
+                //! Precedes every string in a pool.  (Entries are aligned to
+                //! alignof(Header) within the pool.)
+                struct Header {
+                    //! The string's hash.
+                    HashType hash;
+                    //! The string's length.
+                    uint16_t length;
+                };
+
                 //! Private constructor for use by the StringPool
                 explicit PooledString(char*);
 
+                //! Returns the bytes a pool needs for a string of the
+                //! provided length (keeping the next entry aligned).
+                static size_t getEntrySize(size_t);
+                //! Writes an entry for a string (of the provided length and
+                //! hash) to a pool.  Returns its characters.
+                static char* writeEntry(uint8_t*, const char*, uint16_t,
+                        HashType);
+                //! Reads the header in front of a pooled string.
+                inline static Header readHeader(const char*);
+
                 //! Raw string pointer referencing to StringPool memory.
                 char* _string;
         };
@@ -1,6 +1,12 @@
 #ifndef     LIBXAOS_CORE_STRINGS_STRING_POOL_H
 #define     LIBXAOS_CORE_STRINGS_STRING_POOL_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "memory/utility/tracking.h"
+#include "strings/HashedString.h"
 
 namespace libxaos {
 
@@ -16,6 +22,7 @@ namespace libxaos {
 
         namespace {
             using IStore = libxaos::memory::IStore;
+            using MemoryTag = libxaos::memory::MemoryTag;
         }
 
         /**
@@ -36,12 +43,61 @@ namespace libxaos {
          *  footprint that NO STRING SHOULD BE LARGER THAN A SHORT'S LENGTH!!!
          *  I REPEAT, MAX LENGTH OF STRING (EXCLUDING NULL CHARACTER) IS
          *  A SHORT (uint16_t).  65536!!!!!
+         *
+         *  Strings are found through an open addressing hash index (keyed by
+         *  each string's HashedString) so process() and contains() don't
+         *  depend on how many strings are pooled.  The index lives in a
+         *  second IStore and doubles (and is rebuilt from the strings) as the
+         *  pool fills.  If that store can't grow the index any further, new
+         *  strings are refused just as if the string store were full.
+         *
+         *  Given a StoreFactory, a pool that fills its store asks the factory
+         *  for another (of at least the size of the string that didn't fit)
+         *  and carries on in that one, up to MAX_STORES stores.  Strings are
+         *  never moved between stores, so every PooledString handed out stays
+         *  valid for the life of the pool.  Without a factory (or once it
+         *  returns nullptr) strings that don't fit are refused as before.
+         *
+         *  A pool can be written out as an image (see writeImage()): its
+         *  entries followed by a finished hash index, all addressed by
+         *  offsets from the start of the image.  openImage() uses such an
+         *  image in place (i.e. straight from a read-only MappedFileStore)
+         *  with nothing to rebuild; only its header is checked.  Strings
+         *  found in the image come back pointing into it.  New strings are
+         *  added to an overflow store (and indexed separately) as usual.
+         *  Images are only readable by builds with the same byte order and
+         *  HashType.
          */
         class StringPool {
 
             public:
-                //! An IStore is required to store strings in memory.
-                StringPool(IStore*);
+                //! The address space reserved for the index when no store is
+                //! provided for it.
+                static constexpr const size_t DEFAULT_INDEX_RESERVE =
+                        sizeof(void*) >= 8 ? size_t(1) << 26 : size_t(1) << 20;
+                //! The number of strings hashed (and prefetched) at once when
+                //! processing many.
+                static constexpr const size_t BATCH_SIZE = 32;
+                //! The most stores a pool will chain together.
+                static constexpr const size_t MAX_STORES = 32;
+                //! Marks the start of a StringPool image.
+                static constexpr const uint32_t IMAGE_MAGIC = 0x49505358;
+                //! The image layout version.  (Change it if the layout or
+                //! the hash function changes!)
+                static constexpr const uint32_t IMAGE_VERSION = 1;
+
+                //! Creates a store of at least the provided size for a pool
+                //! that has filled its last one (or returns nullptr).  The
+                //! pool acquires ownership of the store.  (May carry state,
+                //! i.e. the arena or growth policy to create stores from.)
+                using StoreFactory = std::function<IStore*(size_t)>;
+
+                //! An IStore is required to store strings in memory (unless a
+                //! StoreFactory will provide one).  Another may be provided
+                //! for the index (otherwise a VirtualStore of
+                //! DEFAULT_INDEX_RESERVE is used).  (Acquires ownership of
+                //! both.)
+                StringPool(IStore*, IStore* = nullptr);
                 ~StringPool();
 
                 //! No copying!
@@ -54,17 +110,138 @@ namespace libxaos {
 
                 //! Add / Get a String to the Pool
                 PooledString process(const char*);
+                //! Add / Get many Strings (strings, count) to the Pool,
+                //! writing each one's PooledString to the results array.
+                //! Returns how many were pooled.  (Faster than one at a
+                //! time; strings are hashed in batches, then looked up.)
+                size_t process(const char* const*, size_t, PooledString*);
                 //! Query if a String is present (const char*)
                 bool contains(const char*) const;
                 //! Query if a String is present (PooledString)
                 bool contains(const PooledString&) const;
 
+                //! Sets the factory used to chain stores once the current
+                //! one fills.  (nullptr turns chaining off.)
+                void setStoreFactory(StoreFactory);
+                //! Returns the factory used to chain stores.
+                const StoreFactory& getStoreFactory() const;
+                //! Returns the number of stores holding strings.
+                size_t getStoreCount() const;
+
+                //! Opens a pool from an image (see writeImage()).  New
+                //! strings go in the overflow store (if one is provided)
+                //! and another may be provided for its index.  (Acquires
+                //! ownership of all three.)  If the image isn't valid, it is
+                //! released and the pool starts out empty.
+                static StringPool openImage(IStore*, IStore* = nullptr,
+                        IStore* = nullptr);
+                //! Returns whether the pool is using an image.
+                bool hasImage() const;
+                //! Returns the number of bytes writeImage() needs (or 0 if
+                //! the pool is too large for an image).
+                size_t getImageSize() const;
+                //! Writes every string in the pool (and an index for them)
+                //! as an image to the provided buffer (of the provided
+                //! size, aligned to at least 8 bytes).  Returns the bytes
+                //! written, or 0 if the image doesn't fit.
+                size_t writeImage(void*, size_t) const;
+
+                //! Sets the tag added strings are recorded under.  (Strings
+                //! that don't fit are recorded as failures.)
+                void setMemoryTag(MemoryTag);
+                //! Returns the tag added strings are recorded under.
+                MemoryTag getMemoryTag() const;
+
             private:
-                //! Where we will store our strings
+                //! An entry in the index.  (A hash of zero marks it empty;
+                //! no non-empty string hashes to EMPTY_STRING_HASH.)
+                struct IndexSlot {
+                    //! The string's characters (in whichever store).
+                    const char* string;
+                    //! The string's hash.
+                    HashType hash;
+                };
+                //! A store in the chain and how much of it is used.
+                struct Segment {
+                    //! The store itself.
+                    //! @todo Replace with UniquePointer (when implemented)
+                    IStore* store;
+                    //! The number of bytes used in the store.
+                    size_t used;
+                };
+
+                //! Starts an image.  (All offsets are from its start.)
+                struct ImageHeader {
+                    //! Always IMAGE_MAGIC.
+                    uint32_t magic;
+                    //! Always IMAGE_VERSION.
+                    uint32_t version;
+                    //! sizeof(HashType) for the build that wrote it.
+                    uint32_t hashSize;
+                    //! The number of strings in the image.
+                    uint32_t count;
+                    //! Where the entries start.
+                    uint32_t entriesOffset;
+                    //! The number of bytes of entries.
+                    uint32_t entriesSize;
+                    //! Where the index starts.
+                    uint32_t indexOffset;
+                    //! The number of slots in the index (a power of two).
+                    uint32_t slotCount;
+                };
+                //! An entry in an image's index.  (A hash of zero marks it
+                //! empty.)
+                struct ImageSlot {
+                    //! Where the string's characters start in the image.
+                    uint32_t offset;
+                    //! The string's hash.
+                    HashType hash;
+                };
+
+                //! Adopts an image if it's valid (otherwise deletes it).
+                void attachImage(IStore*);
+                //! Finds a string (of the provided length and hash) in the
+                //! image, or returns nullptr.
+                const char* findInImage(const char*, size_t, HashType) const;
+
+                //! Adds / Gets a string of the provided length and hash.
+                PooledString intern(const char*, size_t, HashType);
+                //! Starts fetching the slots a hash is probed from.
+                void prefetchSlots(HashType) const;
+
+                //! Finds the slot holding a string of the provided length and
+                //! hash (or the empty slot it would go in).  Returns nullptr
+                //! if there's no index.
+                IndexSlot* findSlot(const char*, size_t, HashType) const;
+                //! Query if a String (of known length and hash) is present
+                bool contains(const char*, size_t, HashType) const;
+                //! Doubles the index (if it can) and re-inserts every string.
+                bool growIndex();
+                //! Returns the segment an entry of the provided size will be
+                //! appended to (chaining a store if needed), or nullptr if
+                //! there's no room for it anywhere.
+                Segment* reserve(size_t);
+
+                //! Where we will store our strings (oldest first)
+                Segment _segments[MAX_STORES];
+                //! The number of stores in _segments.
+                size_t _segmentCount;
+                //! Where we get more stores from.
+                StoreFactory _factory;
+                //! Where we keep the index.
+                //! @todo Replace with UniquePointer (when implemented)
+                IStore* _indexStore;
+                //! The image we were opened from (if any).
                 //! @todo Replace with UniquePointer (when implemented)
-                IStore* _store;
+                IStore* _imageStore;
+                //! Cached pointer to the image's header.
+                const ImageHeader* _image;
                 //! The number of strings in the pool.  Needed for adding.
                 unsigned int _count;
+                //! The number of slots in the index (a power of two).
+                size_t _slotCount;
+                //! The tag added strings are recorded under.
+                MemoryTag _tag;
         };
 
     }
@@ -0,0 +1,59 @@
+/**
+ *  @file kernels.h
+ *  @brief String Kernels
+ *
+ *  This file contains the routines HashedString and the string pools spend
+ *  their time in: measuring a string, comparing two strings of a known
+ *  length, and hashing a range of characters.
+ *
+ *  Every kernel gives exactly the result of the plain byte-at-a-time
+ *  version; only the speed differs.  (Hashes in particular MUST match the
+ *  compile-time HashedString::hash().)  The djb2 hash is rewritten as a
+ *  dot product with powers of 33, so a whole block of characters can be
+ *  folded into the hash at once rather than one multiply per character.
+ *  On Intel CPUs the kernel is chosen at runtime:
+ *  - AVX2 : 32 bytes at a time.
+ *  - SSE4.2 : 16 bytes at a time.  (Length and equality only need SSE2, but
+ *    the hash needs SSE4.1's 32-bit multiply.)
+ *  - PLAIN : 8 characters at a time with scalar code.
+ *
+ *  The vector hashes only handle djb2; wide hashes (FNV-1a, see
+ *  LIBXAOS_FLAG_WIDE_HASHES in HashedString.h) always use the plain kernel.
+ *
+ *  stringLength() reads aligned blocks, so it may read past the end of the
+ *  string (but never into another page).
+ */
+
+#ifndef     LIBXAOS_CORE_STRINGS_UTILITY_KERNELS_H
+#define     LIBXAOS_CORE_STRINGS_UTILITY_KERNELS_H
+
+#include <cstddef>
+
+#include "strings/HashedString.h"
+
+namespace libxaos {
+    namespace strings {
+
+        //! The kernels string operations may be handed to.
+        enum StringKernel {
+            STRING_KERNEL_PLAIN,
+            STRING_KERNEL_SSE42,
+            STRING_KERNEL_AVX2
+        };
+
+        //! Returns the kernel this CPU uses for string operations.
+        StringKernel getStringKernel();
+
+        //! Returns the length of a string (excluding the null character).
+        size_t stringLength(const char*);
+        //! Determines if the first length characters of two strings match.
+        //! (Compare the strings' lengths first.)
+        bool stringsEqual(const char*, const char*, size_t);
+        //! Continues a hash (see HashedString) over length characters.
+        //! Returns the raw hash; it isn't moved off the reserved values.
+        HashType hashRange(const char*, size_t, HashType);
+
+    }
+}
+
+#endif   // LIBXAOS_CORE_STRINGS_UTILITY_KERNELS_H
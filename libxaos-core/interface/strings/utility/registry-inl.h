@@ -0,0 +1,20 @@
+/**
+ *  @file registry-inl.h
+ *  @brief Inline implements: libxaos-core:strings/utility/registry.h
+ *
+ *  When the registry is compiled out, recording does nothing at all.
+ */
+
+#ifndef LIBXAOS_FLAG_HASH_REGISTRY
+
+namespace libxaos {
+    namespace strings {
+
+        inline bool recordHashedString(HashType, const char*, size_t) {
+            return true;
+        }
+
+    }
+}
+
+#endif   // LIBXAOS_FLAG_HASH_REGISTRY
@@ -0,0 +1,77 @@
+/**
+ *  @file registry.h
+ *  @brief HashedString Collision Registry
+ *
+ *  This file contains a record of every string HashedString has hashed, so
+ *  that two different strings landing on the same hash are caught when the
+ *  second is hashed (rather than when something compares equal that
+ *  shouldn't), and so a hash can be turned back into its string for
+ *  diagnostics.
+ *
+ *  The registry is compiled out unless the following flag is defined:
+ *  - LIBXAOS_FLAG_HASH_REGISTRY : Record every hashed string.  (The Debug
+ *    targets define it.)
+ *
+ *  When it isn't defined recording is an empty inline, so hashing costs
+ *  nothing extra.  The queries may still be used; nothing is ever found.
+ *  (HASH_REGISTRY_ENABLED reports which.)  When it is defined, every
+ *  runtime HashedString takes a lock and a map lookup - fine for debugging,
+ *  not for shipping.
+ *
+ *  Compile-time hashes (HashedString::hash() and _hs) can't be recorded;
+ *  they're found once the same string is hashed at runtime.  nullptr and
+ *  empty strings are never recorded.
+ *
+ *  The registry is thread safe.
+ */
+
+#ifndef     LIBXAOS_CORE_STRINGS_UTILITY_REGISTRY_H
+#define     LIBXAOS_CORE_STRINGS_UTILITY_REGISTRY_H
+
+#include <cstddef>
+
+#include "strings/HashedString.h"
+
+namespace libxaos {
+    namespace strings {
+
+        //! True if hashed strings are being recorded.
+        #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+            constexpr bool HASH_REGISTRY_ENABLED = true;
+        #else
+            constexpr bool HASH_REGISTRY_ENABLED = false;
+        #endif
+
+        //! Called when a string hashes to the same value as a different,
+        //! already recorded string.  Receives the hash, the recorded string
+        //! and the new string.  (Called with the registry locked; don't hash
+        //! anything from it!)
+        using HashCollisionHandler = void (*)(HashType, const char*,
+                const char*);
+
+        //! Sets the handler called on each collision (nullptr for none).
+        //! Collisions are counted either way.
+        void setHashCollisionHandler(HashCollisionHandler);
+        //! Returns the string recorded for a hash (or nullptr if none is).
+        //! The string stays valid for the life of the program.
+        const char* lookupHashedString(HashType);
+        //! Returns the number of distinct strings recorded.
+        size_t getHashedStringCount();
+        //! Returns the number of collisions found.
+        size_t getHashCollisionCount();
+
+        #ifdef LIBXAOS_FLAG_HASH_REGISTRY
+            //! Records a string (of the provided length) and its hash.
+            //! Returns false if a different string already has the hash.
+            bool recordHashedString(HashType, const char*, size_t);
+        #else
+            inline bool recordHashedString(HashType, const char*, size_t);
+        #endif
+
+    }
+}
+
+// Pull in the (empty) inline implementations
+#include "strings/utility/registry-inl.h"
+
+#endif   // LIBXAOS_CORE_STRINGS_UTILITY_REGISTRY_H
@@ -0,0 +1,92 @@
+/**
+ *  @file Test_Allocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/Allocator.h
+ *
+ *  Steers standard containers onto libxaos allocators and verifies their
+ *  memory comes from the right place.
+ */
+
+#include <list>
+#include <map>
+#include <new>
+#include <vector>
+
+#include "memory/allocator/Allocator.h"
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/allocator/impl/PoolAllocator.h"
+#include "memory/allocator/impl/TLSFAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::memory;
+
+// Define some types
+using Store = StaticStore<4096, 16, 6>;
+using LargeStore = StaticStore<64 * 1024, 16, 7>;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/Allocator | Vectors can use arenas",
+        "[core][memory]") {
+    LinearAllocator arena {new Store()};
+    std::vector<int, Allocator<int, LinearAllocator>> values {
+            Allocator<int, LinearAllocator> {arena}};
+
+    for (int i = 0; i < 100; i++) {
+        values.push_back(i);
+    }
+    REQUIRE(arena.owns(values.data()));
+    REQUIRE(values[99] == 99);
+
+    // The arena runs out long before the system does.
+    bool threw = false;
+    try {
+        values.resize(100000);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    REQUIRE(values.size() == 100);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/Allocator | Node containers can use pools",
+        "[core][memory]") {
+    using Pool = PoolAllocator<4 * sizeof(void*), alignof(void*)>;
+    Pool pool {new Store()};
+    std::list<int, Allocator<int, Pool>> values {Allocator<int, Pool> {pool}};
+
+    for (int i = 0; i < 10; i++) {
+        values.push_back(i);
+    }
+    REQUIRE(pool.getFreeCount() == pool.getBlockCount() - 10);
+    REQUIRE(pool.owns(&values.front()));
+
+    values.pop_front();
+    REQUIRE(pool.getFreeCount() == pool.getBlockCount() - 9);
+    values.clear();
+    REQUIRE(pool.getFreeCount() == pool.getBlockCount());
+
+    // Anything that doesn't fit a block is refused.
+    REQUIRE(pool.allocate(Pool::BLOCK_SIZE + 1, 1) == nullptr);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/Allocator | Rebinding keeps the allocator",
+        "[core][memory]") {
+    using MapAllocator = Allocator<std::pair<const int, int>, TLSFAllocator>;
+    TLSFAllocator tlsf {new LargeStore()};
+
+    {
+        std::map<int, int, std::less<int>, MapAllocator> values {
+                std::less<int>(), MapAllocator {tlsf}};
+        for (int i = 0; i < 50; i++) {
+            values[i] = i * i;
+        }
+        REQUIRE(values[7] == 49);
+        REQUIRE(tlsf.getStatistics().allocationCount == 50);
+
+        Allocator<char, TLSFAllocator> rebound {values.get_allocator()};
+        REQUIRE(rebound == values.get_allocator());
+        REQUIRE(rebound.getAllocator() == &tlsf);
+    }
+    REQUIRE(tlsf.getStatistics().allocationCount == 0);
+}
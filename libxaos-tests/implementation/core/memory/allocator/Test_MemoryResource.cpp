@@ -0,0 +1,62 @@
+/**
+ *  @file Test_MemoryResource.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/MemoryResource.h
+ *
+ *  Steers std::pmr containers onto libxaos allocators.  (Only built as C++17
+ *  or later.)
+ */
+
+#include "memory/allocator/MemoryResource.h"
+
+#if __cplusplus >= 201703L
+
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "memory/allocator/impl/TLSFAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::memory;
+
+// Define some types
+using Store = StaticStore<64 * 1024, 16, 8>;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/MemoryResource | pmr containers can use "
+        "libxaos allocators", "[core][memory]") {
+    TLSFAllocator tlsf {new Store()};
+    MemoryResource<TLSFAllocator> resource {tlsf};
+
+    {
+        std::pmr::vector<std::pmr::string> strings {&resource};
+        for (int i = 0; i < 20; i++) {
+            strings.emplace_back("a string long enough to skip SSO " +
+                    std::to_string(i));
+        }
+        REQUIRE(tlsf.owns(strings.data()));
+        REQUIRE(tlsf.owns(strings.back().data()));
+        REQUIRE(strings.back().get_allocator().resource() == &resource);
+    }
+    REQUIRE(tlsf.getStatistics().allocationCount == 0);
+
+    REQUIRE(resource.is_equal(resource));
+    MemoryResource<TLSFAllocator> other {tlsf};
+    REQUIRE_FALSE(resource.is_equal(other));
+
+    // Failures throw, as memory_resource requires.
+    bool threw = false;
+    void* pointer = nullptr;
+    try {
+        pointer = resource.allocate(1024 * 1024);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    REQUIRE(pointer == nullptr);
+}
+
+#endif   // __cplusplus >= 201703L
@@ -0,0 +1,81 @@
+/**
+ *  @file Test_NumaPools.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/NumaPools.h
+ *
+ *  Builds an allocator per node over NumaStores and verifies threads are
+ *  handed one of them.  On a single node machine there's only one.
+ */
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "memory/allocator/NumaPools.h"
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/store/impl/NumaStore.h"
+#include "memory/utility/numa.h"
+
+#include "catch.hpp"
+
+// Define some types
+using LinearAllocator = libxaos::memory::LinearAllocator;
+using NumaPools = libxaos::memory::NumaPools<LinearAllocator>;
+using NumaStore = libxaos::memory::NumaStore;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/NumaPools | Builds an allocator per node",
+        "[core][memory]") {
+    size_t built = 0;
+    NumaPools pools {[&built](size_t node) {
+        built++;
+        return new LinearAllocator(new NumaStore(64 * 1024, node));
+    }};
+
+    size_t nodeCount = libxaos::memory::getNumaNodeCount();
+    REQUIRE(nodeCount >= 1);
+    REQUIRE(pools.getNodeCount() == nodeCount);
+    REQUIRE(built == nodeCount);
+    for (size_t node = 0; node < nodeCount; node++) {
+        REQUIRE(pools.get(node).getCapacity() >= 64 * 1024);
+    }
+
+    // Every thread gets one of the allocators (the node it's on).
+    std::vector<LinearAllocator*> local(4, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < local.size(); i++) {
+        threads.emplace_back([&pools, &local, i]() {
+            local[i] = &pools.getLocal();
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (LinearAllocator* allocator : local) {
+        bool found = false;
+        for (size_t node = 0; node < nodeCount; node++) {
+            found = found || allocator == &pools.get(node);
+        }
+        REQUIRE(found);
+    }
+
+    void* block = pools.get(0).allocate(100);
+    REQUIRE(block);
+    REQUIRE(pools.get(0).owns(block));
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/NumaPools | Preferring a node is harmless",
+        "[core][memory]") {
+    size_t node = libxaos::memory::getCurrentNumaNode();
+    REQUIRE(node < libxaos::memory::getNumaNodeCount());
+    REQUIRE_FALSE(libxaos::memory::setPreferredNumaNode(
+            libxaos::memory::MAX_NUMA_NODES));
+
+    // Binding may not be allowed here; it just mustn't break anything.
+    uint8_t last = 0;
+    std::thread thread {[node, &last]() {
+        libxaos::memory::setPreferredNumaNode(node);
+        std::vector<uint8_t> data(1024, 7);
+        last = data[1023];
+    }};
+    thread.join();
+    REQUIRE(last == 7);
+}
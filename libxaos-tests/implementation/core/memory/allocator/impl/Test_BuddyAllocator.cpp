@@ -0,0 +1,172 @@
+/**
+ *  @file Test_BuddyAllocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/BuddyAllocator.h
+ *
+ *  Constructs BuddyAllocators over StaticStores and verifies that blocks are
+ *  split and merged correctly, that they're aligned to their size, and that
+ *  the statistics track fragmentation.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "memory/allocator/impl/BuddyAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::StaticStore<64 * 1024, 4096, 9>;
+using LowAlignedStore = libxaos::memory::StaticStore<64 * 1024, 4, 19>;
+using BuddyAllocator = libxaos::memory::BuddyAllocator;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/BuddyAllocator | Can split and merge",
+        "[core][memory]") {
+    BuddyAllocator allocator {new Store()};
+    BuddyAllocator::Statistics initial = allocator.getStatistics();
+    std::vector<size_t> initialCounts;
+    for (size_t order = 0; order < allocator.getOrderCount(); order++) {
+        initialCounts.push_back(allocator.getFreeBlockCount(order));
+    }
+
+    // The bitmaps take a little off the end, so the store can't be a single
+    // block; it's carved into the largest blocks that fit instead.
+    REQUIRE(allocator.getMinBlockSize() == 256);
+    REQUIRE(initial.usedBytes == 0);
+    REQUIRE(initial.freeBytes > 60 * 1024);
+    REQUIRE(initial.largestFreeBlock == 32 * 1024);
+    REQUIRE(initial.freeBlockCount > 1);
+
+    void* small = allocator.allocate(100);
+    REQUIRE(small);
+    REQUIRE(allocator.owns(small));
+    REQUIRE(allocator.getAllocationSize(small) == 256);
+    REQUIRE(allocator.getStatistics().usedBytes == 256);
+
+    void* large = allocator.allocate(5000);
+    REQUIRE(large);
+    REQUIRE(allocator.getAllocationSize(large) == 8192);
+    REQUIRE(reinterpret_cast<uintptr_t>(large) % 4096 == 0);
+
+    allocator.deallocate(small);
+    allocator.deallocate(large);
+
+    // Everything should have merged back.
+    BuddyAllocator::Statistics final = allocator.getStatistics();
+    REQUIRE(final.usedBytes == 0);
+    REQUIRE(final.allocationCount == 0);
+    REQUIRE(final.freeBlockCount == initial.freeBlockCount);
+    REQUIRE(final.largestFreeBlock == initial.largestFreeBlock);
+    for (size_t order = 0; order < allocator.getOrderCount(); order++) {
+        REQUIRE(allocator.getFreeBlockCount(order) == initialCounts[order]);
+    }
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/BuddyAllocator | Allocates from "
+        "low-alignment stores", "[core][memory]") {
+    BuddyAllocator allocator {new LowAlignedStore()};
+
+    // The default alignment works even though the store promises less.
+    void* blockA = allocator.allocate(64);
+    void* blockB = allocator.allocate(64, 4);
+    void* blockC = allocator.allocate(1000);
+    REQUIRE(blockA);
+    REQUIRE(blockB);
+    REQUIRE(blockC);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockA) %
+            alignof(std::max_align_t) == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockB) %
+            alignof(std::max_align_t) == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockC) %
+            alignof(std::max_align_t) == 0);
+    REQUIRE(allocator.owns(blockA));
+
+    allocator.deallocate(blockA);
+    allocator.deallocate(blockB);
+    allocator.deallocate(blockC);
+    REQUIRE(allocator.getStatistics().usedBytes == 0);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/BuddyAllocator | Tracks fragmentation",
+        "[core][memory]") {
+    BuddyAllocator allocator {new Store()};
+
+    REQUIRE(allocator.allocate(64 * 1024) == nullptr);
+    REQUIRE(allocator.allocate(16, 8192) == nullptr); // Beyond the store.
+
+    std::vector<void*> blocks;
+    void* block = nullptr;
+    while ((block = allocator.allocate(1024)) != nullptr) {
+        blocks.push_back(block);
+    }
+    REQUIRE(blocks.size() >= 60);
+    REQUIRE(allocator.getStatistics().largestFreeBlock < 1024);
+
+    // Free every other block; none of them can merge.
+    for (size_t i = 0; i < blocks.size(); i += 2) {
+        allocator.deallocate(blocks[i]);
+    }
+    BuddyAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.largestFreeBlock == 1024);
+    REQUIRE(statistics.fragmentation > 0.9);
+    REQUIRE(allocator.allocate(2048) == nullptr);
+
+    // Free the rest and they all merge.
+    for (size_t i = 1; i < blocks.size(); i += 2) {
+        allocator.deallocate(blocks[i]);
+    }
+    REQUIRE(allocator.getStatistics().largestFreeBlock == 32 * 1024);
+    REQUIRE(allocator.allocate(32 * 1024));
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/BuddyAllocator | Survives random use",
+        "[core][memory]") {
+    BuddyAllocator allocator {new Store(), 64};
+    BuddyAllocator::Statistics initial = allocator.getStatistics();
+    std::mt19937 random {4321};
+
+    struct Allocation {
+        uint8_t* pointer;
+        size_t size;
+        uint8_t pattern;
+    };
+    std::vector<Allocation> live;
+
+    for (int i = 0; i < 5000; i++) {
+        if (live.empty() || random() % 3 != 0) {
+            size_t size = 1 + random() % 2048;
+            uint8_t* pointer = static_cast<uint8_t*>(
+                    allocator.allocate(size));
+            if (pointer) {
+                size_t blockSize = allocator.getAllocationSize(pointer);
+                REQUIRE(blockSize >= size);
+                REQUIRE(reinterpret_cast<uintptr_t>(pointer) %
+                        (blockSize < 4096 ? blockSize : 4096) == 0);
+                uint8_t pattern = static_cast<uint8_t>(random());
+                memset(pointer, pattern, size);
+                live.push_back(Allocation {pointer, size, pattern});
+            }
+        } else {
+            size_t index = random() % live.size();
+            Allocation allocation = live[index];
+            for (size_t j = 0; j < allocation.size; j++) {
+                REQUIRE(allocation.pointer[j] == allocation.pattern);
+            }
+            allocator.deallocate(allocation.pointer);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    REQUIRE(allocator.getStatistics().allocationCount == live.size());
+    for (Allocation& allocation : live) {
+        allocator.deallocate(allocation.pointer);
+    }
+    BuddyAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.usedBytes == 0);
+    REQUIRE(statistics.freeBlockCount == initial.freeBlockCount);
+    REQUIRE(statistics.largestFreeBlock == initial.largestFreeBlock);
+}
@@ -0,0 +1,77 @@
+/**
+ *  @file Test_LinearAllocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/LinearAllocator.h
+ *
+ *  Constructs LinearAllocators over StaticStores and verifies that memory is
+ *  handed out aligned, in order, and can be rewound and reset.
+ */
+
+#include <cstdint>
+
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::StaticStore<256, 16, 0>;
+using LinearAllocator = libxaos::memory::LinearAllocator;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/LinearAllocator | Can allocate memory",
+        "[core][memory]") {
+    LinearAllocator allocator {new Store()}; // acquires ownership
+
+    void* blockA = allocator.allocate(10);
+    void* blockB = allocator.allocate(10);
+
+    REQUIRE(blockA);
+    REQUIRE(blockB);
+    REQUIRE(blockA != blockB);
+    REQUIRE(allocator.owns(blockA));
+    REQUIRE(allocator.owns(blockB));
+    REQUIRE(allocator.getUsed() >= 20);
+    REQUIRE(allocator.getCapacity() == 256);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/LinearAllocator | Allocations are "
+        "aligned.", "[core][memory]") {
+    LinearAllocator allocator {new Store()};
+
+    allocator.allocate(1, 1); // Knock us off of any natural alignment
+    void* blockA = allocator.allocate(4, 4);
+    allocator.allocate(1, 1);
+    void* blockB = allocator.allocate(8, 32);
+
+    REQUIRE(reinterpret_cast<uintptr_t>(blockA) % 4 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockB) % 32 == 0);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/LinearAllocator | Can rewind and reset",
+        "[core][memory]") {
+    LinearAllocator allocator {new Store()};
+
+    allocator.allocate(32);
+    LinearAllocator::Marker marker = allocator.getMarker();
+    void* blockA = allocator.allocate(64);
+    allocator.allocate(64);
+
+    allocator.rewind(marker);
+    REQUIRE(allocator.getUsed() == marker);
+    REQUIRE(allocator.allocate(64) == blockA);
+
+    allocator.reset();
+    REQUIRE(allocator.getUsed() == 0);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/LinearAllocator | Exhaustion returns "
+        "nullptr", "[core][memory]") {
+    LinearAllocator allocator {new Store()};
+
+    REQUIRE(allocator.allocate(257) == nullptr);
+    REQUIRE(allocator.getUsed() == 0);
+
+    REQUIRE(allocator.allocate(200));
+    size_t used = allocator.getUsed();
+    REQUIRE(allocator.allocate(100) == nullptr);
+    REQUIRE(allocator.getUsed() == used); // Failure leaves us untouched
+}
@@ -0,0 +1,105 @@
+/**
+ *  @file Test_PoolAllocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/PoolAllocator.h
+ *  @brief Tests: libxaos-core:memory/allocator/impl/ObjectPool.h
+ *
+ *  Constructs PoolAllocators and ObjectPools over StaticStores and verifies
+ *  that blocks are handed out, recycled, and exhausted properly.
+ */
+
+#include <cstdint>
+#include <utility>
+
+#include "memory/allocator/impl/ObjectPool.h"
+#include "memory/allocator/impl/PoolAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::StaticStore<256, 16, 1>;
+using Pool = libxaos::memory::PoolAllocator<24, 16>;
+
+namespace {
+    // A simple object that counts its own lifecycle.
+    struct Counted {
+        Counted(int value, int* destroyed) :
+                _value(value), _destroyed(destroyed) {}
+        ~Counted() { (*_destroyed)++; }
+
+        Counted(const Counted&) = delete;
+        Counted& operator=(const Counted&) = delete;
+
+        int _value;
+        int* _destroyed;
+    };
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/PoolAllocator | Can allocate blocks",
+        "[core][memory]") {
+    Pool pool {new Store()}; // acquires ownership
+
+    REQUIRE(Pool::BLOCK_SIZE == 32);
+    REQUIRE(pool.getBlockCount() >= 7);
+
+    void* blockA = pool.allocate();
+    void* blockB = pool.allocate();
+
+    REQUIRE(blockA);
+    REQUIRE(blockB);
+    REQUIRE(blockA != blockB);
+    REQUIRE(pool.owns(blockA));
+    REQUIRE(reinterpret_cast<uintptr_t>(blockA) % 16 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockB) % 16 == 0);
+    REQUIRE(pool.getFreeCount() == pool.getBlockCount() - 2);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/PoolAllocator | Blocks are recycled",
+        "[core][memory]") {
+    Pool pool {new Store()};
+
+    void* blockA = pool.allocate();
+    pool.allocate();
+    pool.deallocate(blockA);
+
+    REQUIRE(pool.allocate() == blockA); // LIFO reuse
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/PoolAllocator | Exhaustion is reported",
+        "[core][memory]") {
+    Pool pool {new Store()};
+
+    size_t count = pool.getBlockCount();
+    for (size_t i = 0; i < count; i++) {
+        REQUIRE(pool.allocate());
+    }
+
+    REQUIRE(pool.isExhausted());
+    REQUIRE(pool.allocate() == nullptr);
+    REQUIRE(pool.allocate() == nullptr);
+    REQUIRE(pool.getExhaustedCount() == 2);
+
+    // Moving a pool takes its count along.
+    Pool moved {std::move(pool)};
+    REQUIRE(moved.getExhaustedCount() == 2);
+    REQUIRE(pool.getExhaustedCount() == 0);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ObjectPool | Can create and destroy "
+        "objects", "[core][memory]") {
+    libxaos::memory::ObjectPool<Counted> pool {new Store()};
+    int destroyed = 0;
+
+    Counted* objectA = pool.create(5, &destroyed);
+    Counted* objectB = pool.create(7, &destroyed);
+
+    REQUIRE(objectA);
+    REQUIRE(objectB);
+    REQUIRE(objectA->_value == 5);
+    REQUIRE(objectB->_value == 7);
+    REQUIRE(pool.owns(objectA));
+
+    pool.destroy(objectA);
+    REQUIRE(destroyed == 1);
+    REQUIRE(pool.create(9, &destroyed) == objectA);
+}
@@ -0,0 +1,150 @@
+/**
+ *  @file Test_RelocatableHeap.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/RelocatableHeap.h
+ *
+ *  Constructs RelocatableHeaps over StaticStores and verifies that handles
+ *  go stale when freed and that defragmenting closes holes without losing
+ *  any data.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "memory/allocator/impl/RelocatableHeap.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::StaticStore<64 * 1024, 16, 10>;
+using RelocatableHeap = libxaos::memory::RelocatableHeap;
+using Handle = RelocatableHeap::Handle;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/RelocatableHeap | Handles are "
+        "generation checked", "[core][memory]") {
+    RelocatableHeap heap {new Store(), 4};
+
+    Handle handle = heap.allocate(100);
+    REQUIRE(heap.isValid(handle));
+    REQUIRE(heap.getSize(handle) >= 100);
+    void* pointer = heap.resolve(handle);
+    REQUIRE(pointer);
+    REQUIRE(reinterpret_cast<uintptr_t>(pointer) %
+            RelocatableHeap::ALIGNMENT == 0);
+    REQUIRE_FALSE(heap.isValid(Handle {}));
+    Handle empty;
+    REQUIRE(empty.generation == 0);
+    REQUIRE_FALSE(heap.isValid(empty));
+    REQUIRE(heap.resolve(empty) == nullptr);
+
+    // Once freed, the handle is stale even when its slot is reused.
+    heap.deallocate(handle);
+    REQUIRE_FALSE(heap.isValid(handle));
+    REQUIRE(heap.resolve(handle) == nullptr);
+    Handle reused = heap.allocate(100);
+    REQUIRE(reused.index == handle.index);
+    REQUIRE_FALSE(heap.isValid(handle));
+    REQUIRE(heap.isValid(reused));
+    heap.deallocate(handle); // Ignored!
+    REQUIRE(heap.isValid(reused));
+
+    // Running out of handles fails cleanly.
+    REQUIRE(heap.isValid(heap.allocate(8)));
+    REQUIRE(heap.isValid(heap.allocate(8)));
+    REQUIRE(heap.isValid(heap.allocate(8)));
+    REQUIRE_FALSE(heap.isValid(heap.allocate(8)));
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/RelocatableHeap | Defragmenting "
+        "closes holes", "[core][memory]") {
+    RelocatableHeap heap {new Store()};
+
+    // Fill the heap with numbered blocks.
+    std::vector<Handle> handles;
+    Handle handle;
+    while (heap.isValid(handle = heap.allocate(1000))) {
+        memset(heap.resolve(handle), static_cast<int>(handles.size()), 1000);
+        handles.push_back(handle);
+    }
+    REQUIRE(handles.size() > 40);
+
+    // Punch holes:  lots of free memory, none of it contiguous.
+    for (size_t i = 0; i < handles.size(); i += 2) {
+        heap.deallocate(handles[i]);
+    }
+    REQUIRE_FALSE(heap.isCompact());
+    REQUIRE(heap.getStatistics().fragmentation > 0.5);
+    REQUIRE_FALSE(heap.isValid(heap.allocate(4000)));
+
+    // A zero budget still makes progress.
+    REQUIRE(heap.defragment(0) > 0);
+    while (!heap.isCompact()) {
+        heap.defragment(100);
+    }
+    REQUIRE(heap.getStatistics().holeBytes == 0);
+    REQUIRE(heap.getStatistics().fragmentation == Approx(0.0));
+    REQUIRE(heap.defragment(100) == 0);
+
+    // Everything survived the move.
+    for (size_t i = 1; i < handles.size(); i += 2) {
+        uint8_t* bytes = static_cast<uint8_t*>(heap.resolve(handles[i]));
+        REQUIRE(bytes);
+        REQUIRE(bytes[0] == static_cast<uint8_t>(i));
+        REQUIRE(bytes[999] == static_cast<uint8_t>(i));
+    }
+    REQUIRE(heap.isValid(heap.allocate(4000)));
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/RelocatableHeap | Survives random use",
+        "[core][memory]") {
+    RelocatableHeap heap {new Store(), 256};
+    std::mt19937 random {2468};
+
+    struct Allocation {
+        Handle handle;
+        size_t size;
+        uint8_t pattern;
+    };
+    std::vector<Allocation> live;
+
+    for (int i = 0; i < 5000; i++) {
+        int action = static_cast<int>(random() % 8);
+        if (live.empty() || action < 4) {
+            size_t size = 1 + random() % 1024;
+            Handle handle = heap.allocate(size);
+            if (heap.isValid(handle)) {
+                uint8_t pattern = static_cast<uint8_t>(random());
+                memset(heap.resolve(handle), pattern, size);
+                live.push_back(Allocation {handle, size, pattern});
+            }
+        } else if (action < 7) {
+            size_t index = random() % live.size();
+            Allocation allocation = live[index];
+            uint8_t* bytes = static_cast<uint8_t*>(
+                    heap.resolve(allocation.handle));
+            for (size_t j = 0; j < allocation.size; j++) {
+                REQUIRE(bytes[j] == allocation.pattern);
+            }
+            heap.deallocate(allocation.handle);
+            live[index] = live.back();
+            live.pop_back();
+        } else {
+            heap.defragment(0);
+        }
+    }
+
+    REQUIRE(heap.getStatistics().handleCount == live.size());
+    for (Allocation& allocation : live) {
+        uint8_t* bytes = static_cast<uint8_t*>(
+                heap.resolve(allocation.handle));
+        for (size_t j = 0; j < allocation.size; j++) {
+            REQUIRE(bytes[j] == allocation.pattern);
+        }
+        heap.deallocate(allocation.handle);
+    }
+    RelocatableHeap::Statistics statistics = heap.getStatistics();
+    REQUIRE(statistics.usedBytes == 0);
+    REQUIRE(statistics.handleCount == 0);
+}
@@ -0,0 +1,102 @@
+/**
+ *  @file Test_StackAllocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/StackAllocator.h
+ *
+ *  Constructs StackAllocators over StaticStores and verifies that both ends
+ *  hand out aligned memory, that they can't overlap, and that Scopes rewind
+ *  them.
+ */
+
+#include <cstdint>
+
+#include "memory/allocator/impl/StackAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::StaticStore<256, 16, 11>;
+using StackAllocator = libxaos::memory::StackAllocator;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/StackAllocator | Can allocate from "
+        "both ends", "[core][memory]") {
+    StackAllocator allocator {new Store()};
+    REQUIRE(allocator.getCapacity() == 256);
+    REQUIRE(allocator.getFree() == 256);
+
+    uint8_t* bottom = static_cast<uint8_t*>(allocator.allocate(10, 1));
+    uint8_t* top = static_cast<uint8_t*>(allocator.allocateTop(10, 1));
+    REQUIRE(bottom);
+    REQUIRE(top);
+    REQUIRE(allocator.owns(bottom));
+    REQUIRE(allocator.owns(top));
+    REQUIRE(top - bottom == 246);
+    REQUIRE(allocator.getUsed() == 10);
+    REQUIRE(allocator.getTopUsed() == 10);
+
+    allocator.allocate(1, 1); // Knock both ends off any natural alignment
+    allocator.allocateTop(1, 1);
+    void* blockA = allocator.allocate(8, 32);
+    void* blockB = allocator.allocateTop(8, 32);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockA) % 32 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockB) % 32 == 0);
+
+    // The ends can't cross.
+    size_t free = allocator.getFree();
+    REQUIRE(allocator.allocate(free + 1, 1) == nullptr);
+    REQUIRE(allocator.allocateTop(free + 1, 1) == nullptr);
+    REQUIRE(allocator.allocateTop(free, 1));
+    REQUIRE(allocator.getFree() == 0);
+    REQUIRE(allocator.allocate(1, 1) == nullptr);
+
+    allocator.reset();
+    REQUIRE(allocator.getFree() == 256);
+    REQUIRE(allocator.allocate(10, 1) == bottom);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/StackAllocator | Can rewind each end",
+        "[core][memory]") {
+    StackAllocator allocator {new Store()};
+
+    allocator.allocate(32);
+    allocator.allocateTop(32);
+    StackAllocator::Marker bottom = allocator.getMarker();
+    StackAllocator::Marker top = allocator.getTopMarker();
+    void* blockA = allocator.allocate(64);
+    void* blockB = allocator.allocateTop(64);
+
+    allocator.rewindTop(top);
+    REQUIRE(allocator.getTopUsed() == 32);
+    REQUIRE(allocator.getUsed() > bottom); // Untouched.
+    REQUIRE(allocator.allocateTop(64) == blockB);
+
+    allocator.rewind(bottom);
+    REQUIRE(allocator.getUsed() == bottom);
+    REQUIRE(allocator.allocate(64) == blockA);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/StackAllocator | Scopes rewind both "
+        "ends", "[core][memory]") {
+    StackAllocator allocator {new Store()};
+    allocator.allocate(16);
+
+    {
+        StackAllocator::Scope outer {allocator};
+        allocator.allocate(16);
+        allocator.allocateTop(16);
+
+        {
+            StackAllocator::Scope inner {allocator};
+            allocator.allocate(64);
+            allocator.allocateTop(64);
+            REQUIRE(allocator.getUsed() == 96);
+            REQUIRE(allocator.getTopUsed() == 80);
+        }
+
+        REQUIRE(allocator.getUsed() == 32);
+        REQUIRE(allocator.getTopUsed() == 16);
+    }
+
+    REQUIRE(allocator.getUsed() == 16);
+    REQUIRE(allocator.getTopUsed() == 0);
+}
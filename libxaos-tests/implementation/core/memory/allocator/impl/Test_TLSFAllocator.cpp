@@ -0,0 +1,149 @@
+/**
+ *  @file Test_TLSFAllocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/TLSFAllocator.h
+ *
+ *  Constructs TLSFAllocators over StaticStores and hammers them with
+ *  allocations of varying sizes, verifying that no two allocations overlap,
+ *  that freed memory is coalesced, and that statistics are sane.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "memory/allocator/impl/TLSFAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::StaticStore<64 * 1024, 16, 2>;
+using TLSFAllocator = libxaos::memory::TLSFAllocator;
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/TLSFAllocator | Can allocate and free",
+        "[core][memory]") {
+    TLSFAllocator allocator {new Store()}; // acquires ownership
+    TLSFAllocator::Statistics initial = allocator.getStatistics();
+
+    REQUIRE(initial.usedBytes == 0);
+    REQUIRE(initial.freeBytes > 60 * 1024);
+    REQUIRE(initial.largestFreeBlock == initial.freeBytes);
+
+    void* blockA = allocator.allocate(100);
+    void* blockB = allocator.allocate(1000, 64);
+    REQUIRE(blockA);
+    REQUIRE(blockB);
+    REQUIRE(allocator.owns(blockA));
+    REQUIRE(reinterpret_cast<uintptr_t>(blockA) %
+            TLSFAllocator::DEFAULT_ALIGNMENT == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockB) % 64 == 0);
+    REQUIRE(allocator.getAllocationSize(blockA) >= 100);
+    REQUIRE(allocator.getStatistics().allocationCount == 2);
+
+    allocator.deallocate(blockA);
+    allocator.deallocate(blockB);
+
+    // Everything should have coalesced back into one block.
+    TLSFAllocator::Statistics final = allocator.getStatistics();
+    REQUIRE(final.usedBytes == 0);
+    REQUIRE(final.allocationCount == 0);
+    REQUIRE(final.freeBytes == initial.freeBytes);
+    REQUIRE(final.largestFreeBlock == initial.freeBytes);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/TLSFAllocator | Can reallocate",
+        "[core][memory]") {
+    TLSFAllocator allocator {new Store()};
+
+    uint8_t* block = static_cast<uint8_t*>(allocator.allocate(64));
+    for (int i = 0; i < 64; i++) {
+        block[i] = static_cast<uint8_t>(i);
+    }
+
+    // Nothing follows us, so this should grow in place.
+    uint8_t* grown = static_cast<uint8_t*>(allocator.reallocate(block, 4096));
+    REQUIRE(grown == block);
+
+    // Block the way and force a move.
+    void* blocker = allocator.allocate(16);
+    uint8_t* moved = static_cast<uint8_t*>(allocator.reallocate(grown, 8192));
+    REQUIRE(moved);
+    REQUIRE(moved != grown);
+    for (int i = 0; i < 64; i++) {
+        REQUIRE(moved[i] == static_cast<uint8_t>(i));
+    }
+
+    REQUIRE(allocator.reallocate(moved, 0) == nullptr);
+    allocator.deallocate(blocker);
+    REQUIRE(allocator.getStatistics().usedBytes == 0);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/TLSFAllocator | Exhaustion returns "
+        "nullptr", "[core][memory]") {
+    TLSFAllocator allocator {new Store()};
+
+    REQUIRE(allocator.allocate(64 * 1024) == nullptr);
+
+    std::vector<void*> blocks;
+    void* block = nullptr;
+    while ((block = allocator.allocate(1024)) != nullptr) {
+        blocks.push_back(block);
+    }
+    REQUIRE(blocks.size() > 50);
+
+    // Punch holes; lots of free memory, but none of it contiguous.
+    for (size_t i = 0; i < blocks.size(); i += 2) {
+        allocator.deallocate(blocks[i]);
+    }
+    TLSFAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.freeBytes > 20 * 1024);
+    REQUIRE(statistics.fragmentation > 0.9);
+    REQUIRE(allocator.allocate(4096) == nullptr);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/TLSFAllocator | Survives random use",
+        "[core][memory]") {
+    TLSFAllocator allocator {new Store()};
+    std::mt19937 random {1234};
+
+    struct Allocation {
+        uint8_t* pointer;
+        size_t size;
+        uint8_t pattern;
+    };
+    std::vector<Allocation> live;
+
+    for (int i = 0; i < 5000; i++) {
+        if (live.empty() || random() % 3 != 0) {
+            size_t size = 1 + random() % 512;
+            size_t alignment = size_t(1) << (random() % 7);
+            uint8_t* pointer = static_cast<uint8_t*>(
+                    allocator.allocate(size, alignment));
+            if (pointer) {
+                REQUIRE(reinterpret_cast<uintptr_t>(pointer) % alignment
+                        == 0);
+                uint8_t pattern = static_cast<uint8_t>(random());
+                memset(pointer, pattern, size);
+                live.push_back(Allocation {pointer, size, pattern});
+            }
+        } else {
+            size_t index = random() % live.size();
+            Allocation allocation = live[index];
+            for (size_t j = 0; j < allocation.size; j++) {
+                REQUIRE(allocation.pointer[j] == allocation.pattern);
+            }
+            allocator.deallocate(allocation.pointer);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    REQUIRE(allocator.getStatistics().allocationCount == live.size());
+    for (Allocation& allocation : live) {
+        allocator.deallocate(allocation.pointer);
+    }
+    TLSFAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.usedBytes == 0);
+    REQUIRE(statistics.largestFreeBlock == statistics.freeBytes);
+}
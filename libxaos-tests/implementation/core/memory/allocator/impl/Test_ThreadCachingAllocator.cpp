@@ -0,0 +1,230 @@
+/**
+ *  @file Test_ThreadCachingAllocator.cpp
+ *  @brief Tests: libxaos-core:memory/allocator/impl/ThreadCachingAllocator.h
+ *
+ *  Constructs ThreadCachingAllocators over VirtualStores and verifies size
+ *  classes, alignment, the large allocation path, and that objects can be
+ *  freed from threads other than the one that allocated them.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "memory/memory.h"
+#include "memory/allocator/impl/ThreadCachingAllocator.h"
+#include "memory/store/IStore.h"
+#include "memory/store/impl/StaticStore.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "memory/utility/alignment.h"
+
+#include "catch.hpp"
+
+// Define some types
+using Store = libxaos::memory::VirtualStore;
+using ThreadCachingAllocator = libxaos::memory::ThreadCachingAllocator;
+using LowAlignedStore = libxaos::memory::StaticStore<8 * 64 * 1024, 4, 18>;
+
+namespace {
+    // A store whose storage is only ever 4-aligned (never 8-aligned).
+    class MisalignedStore : public libxaos::memory::IStore {
+        public:
+            explicit MisalignedStore(size_t size) :
+                    IStore(size, 4), _buffer(size + 16) {}
+
+            uint8_t* getRawStorage() {
+                return libxaos::memory::alignUp(_buffer.data(), 16) + 4;
+            }
+
+        private:
+            std::vector<uint8_t> _buffer;
+    };
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | Size classes "
+        "cover every small size", "[core][memory]") {
+    size_t previous = 0;
+    for (size_t i = 0; i < ThreadCachingAllocator::SIZE_CLASS_COUNT; i++) {
+        size_t size = ThreadCachingAllocator::getClassSize(i);
+        REQUIRE(size > previous);
+        REQUIRE(ThreadCachingAllocator::getSizeClass(size) == i);
+        REQUIRE(ThreadCachingAllocator::getSizeClass(previous + 1) == i);
+        previous = size;
+    }
+    REQUIRE(previous == ThreadCachingAllocator::MAX_SMALL_SIZE);
+
+    // Waste is bounded to a quarter of the request (past the first classes).
+    for (size_t size = 129; size <= 32 * 1024; size += 7) {
+        size_t classSize = ThreadCachingAllocator::getClassSize(
+                ThreadCachingAllocator::getSizeClass(size));
+        REQUIRE(classSize >= size);
+        REQUIRE(classSize - size <= size / 4);
+    }
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | Can allocate "
+        "and free", "[core][memory]") {
+    ThreadCachingAllocator allocator {new Store(16 * 1024 * 1024)};
+
+    void* blockA = allocator.allocate(24);
+    void* blockB = allocator.allocate(24);
+    void* blockC = allocator.allocate(1000);
+    REQUIRE(blockA);
+    REQUIRE(blockB);
+    REQUIRE(blockC);
+    REQUIRE(blockA != blockB);
+    REQUIRE(allocator.owns(blockA));
+    REQUIRE(allocator.owns(blockC));
+    REQUIRE(allocator.getAllocationSize(blockA) == 32);
+    REQUIRE(allocator.getAllocationSize(blockC) >= 1000);
+    REQUIRE(reinterpret_cast<uintptr_t>(blockA) %
+            ThreadCachingAllocator::DEFAULT_ALIGNMENT == 0);
+
+    // Freed objects are reused (most recently freed first).
+    allocator.deallocate(blockB);
+    REQUIRE(allocator.allocate(20) == blockB);
+
+    allocator.deallocate(blockA);
+    allocator.deallocate(blockB);
+    allocator.deallocate(blockC);
+    allocator.deallocate(nullptr);
+    allocator.flushThreadCache();
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | Aligns "
+        "objects in low-alignment stores", "[core][memory]") {
+    ThreadCachingAllocator statically {new LowAlignedStore()};
+    ThreadCachingAllocator misaligned {new MisalignedStore(8 * 64 * 1024)};
+
+    for (ThreadCachingAllocator* allocator : {&statically, &misaligned}) {
+        std::vector<void*> blocks {};
+        for (int i = 0; i < 100; i++) {
+            void* block = allocator->allocate(48);
+            REQUIRE(block);
+            REQUIRE(libxaos::memory::isAligned(block,
+                    ThreadCachingAllocator::DEFAULT_ALIGNMENT));
+            blocks.push_back(block);
+        }
+        void* wide = allocator->allocate(32 * 1024, 8);
+        REQUIRE(wide);
+        REQUIRE(libxaos::memory::isAligned(wide,
+                ThreadCachingAllocator::DEFAULT_ALIGNMENT));
+        blocks.push_back(wide);
+
+        for (void* block : blocks) {
+            REQUIRE(allocator->owns(block));
+            allocator->deallocate(block);
+        }
+        allocator->flushThreadCache();
+    }
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | Handles "
+        "alignment and large allocations", "[core][memory]") {
+    ThreadCachingAllocator allocator {new Store(16 * 1024 * 1024)};
+
+    for (size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+        void* block = allocator.allocate(100, alignment);
+        REQUIRE(block);
+        REQUIRE(reinterpret_cast<uintptr_t>(block) % alignment == 0);
+        allocator.deallocate(block);
+    }
+
+    uint8_t* large = static_cast<uint8_t*>(allocator.allocate(1024 * 1024));
+    REQUIRE(large);
+    REQUIRE_FALSE(allocator.owns(large));
+    REQUIRE(allocator.getAllocationSize(large) == 1024 * 1024);
+    memset(large, 0xAB, 1024 * 1024);
+    allocator.deallocate(large);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | Falls back "
+        "when the store is full", "[core][memory]") {
+    // Room for the span table and a couple of spans only.
+    ThreadCachingAllocator allocator {new Store(4 *
+            ThreadCachingAllocator::SPAN_SIZE)};
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 64; i++) {
+        void* block = allocator.allocate(8 * 1024);
+        REQUIRE(block);
+        blocks.push_back(block);
+    }
+    REQUIRE(allocator.owns(blocks.front()));
+    REQUIRE_FALSE(allocator.owns(blocks.back()));
+
+    for (void* block : blocks) {
+        allocator.deallocate(block);
+    }
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | Objects may "
+        "be freed by other threads", "[core][memory]") {
+    ThreadCachingAllocator allocator {new Store(64 * 1024 * 1024)};
+    const int COUNT = 10000;
+    std::vector<void*> blocks(COUNT);
+
+    // One thread allocates, another frees.
+    std::thread producer {[&]() {
+        for (int i = 0; i < COUNT; i++) {
+            blocks[i] = allocator.allocate(16 + (i % 64) * 8);
+            memset(blocks[i], i & 0xFF, 16);
+        }
+    }};
+    producer.join();
+
+    std::thread consumer {[&]() {
+        for (int i = 0; i < COUNT; i++) {
+            allocator.deallocate(blocks[i]);
+        }
+    }};
+    consumer.join();
+
+    // Hammer it from a few threads at once.
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.push_back(std::thread {[&allocator]() {
+            std::vector<uint8_t*> live;
+            for (int i = 0; i < 5000; i++) {
+                size_t size = 1 + (i * 37) % 2048;
+                uint8_t* block = static_cast<uint8_t*>(
+                        allocator.allocate(size));
+                block[0] = 0x5A;
+                block[size - 1] = 0xA5;
+                live.push_back(block);
+                if (i % 3 == 0) {
+                    allocator.deallocate(live.front());
+                    live.erase(live.begin());
+                }
+            }
+            for (uint8_t* block : live) {
+                allocator.deallocate(block);
+            }
+        }});
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // The spans carved by exited threads are reused rather than growing.
+    size_t spans = allocator.getSpanCount();
+    std::thread again {[&allocator]() {
+        for (int i = 0; i < 1000; i++) {
+            allocator.deallocate(allocator.allocate(64));
+        }
+    }};
+    again.join();
+    REQUIRE(allocator.getSpanCount() == spans);
+}
+
+TEST_CASE("CORE:MEMORY/ALLOCATOR/IMPL/ThreadCachingAllocator | The global "
+        "allocator is usable", "[core][memory]") {
+    ThreadCachingAllocator& global = libxaos::memory::getGlobalAllocator();
+    REQUIRE(&global == &libxaos::memory::getGlobalAllocator());
+
+    void* block = global.allocate(48);
+    REQUIRE(block);
+    REQUIRE(global.owns(block));
+    global.deallocate(block);
+}
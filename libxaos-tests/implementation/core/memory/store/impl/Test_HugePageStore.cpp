@@ -0,0 +1,53 @@
+/**
+ *  @file Test_HugePageStore.cpp
+ *  @brief Tests: libxaos-core:memory/store/impl/HugePageStore.h
+ *
+ *  Creates HugePageStores and verifies they hold data.  Which kind of page
+ *  ends up backing the store depends on the machine, so any is accepted.
+ */
+
+#include <cstdint>
+
+#include "memory/store/impl/HugePageStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/pages.h"
+#include "strings/PooledString.h"
+#include "strings/StringPool.h"
+
+#include "catch.hpp"
+
+// Define some types
+using HugePageStore = libxaos::memory::HugePageStore;
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/HugePageStore | Stores hold data",
+        "[core][memory]") {
+    size_t hugePageSize = libxaos::memory::getHugePageSize();
+    HugePageStore store {hugePageSize + 1, true};
+
+    REQUIRE(store.getRawStorage());
+    REQUIRE(store.SIZE == 2 * hugePageSize); // Rounded up
+    REQUIRE(libxaos::memory::isAligned(store.getRawStorage(),
+            store.ALIGNMENT));
+
+    uint8_t* storage = store.getRawStorage();
+    for (size_t i = 0; i < store.SIZE; i += 4096) {
+        storage[i] = static_cast<uint8_t>(i / 4096);
+    }
+    for (size_t i = 0; i < store.SIZE; i += 4096) {
+        REQUIRE(storage[i] == static_cast<uint8_t>(i / 4096));
+    }
+
+    INFO("Page kind: " << store.getPageKind());
+    REQUIRE((store.getPageKind() == HugePageStore::EXPLICIT ||
+            store.getPageKind() == HugePageStore::TRANSPARENT ||
+            store.getPageKind() == HugePageStore::NORMAL));
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/HugePageStore | Stores work with pools",
+        "[core][memory]") {
+    libxaos::strings::StringPool pool {new HugePageStore()};
+
+    libxaos::strings::PooledString string = pool.process("HUGE!");
+    REQUIRE(string);
+    REQUIRE(pool.contains("HUGE!"));
+}
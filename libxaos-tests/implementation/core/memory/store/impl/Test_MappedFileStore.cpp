@@ -0,0 +1,90 @@
+/**
+ *  @file Test_MappedFileStore.cpp
+ *  @brief Tests: libxaos-core:memory/store/impl/MappedFileStore.h
+ *
+ *  Writes a scratch file, maps it, and verifies its contents show up in the
+ *  store.  Copy-on-write stores must never modify the file.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "memory/store/impl/MappedFileStore.h"
+#include "memory/utility/alignment.h"
+
+#include "catch.hpp"
+
+// Define some types
+using MappedFileStore = libxaos::memory::MappedFileStore;
+
+namespace {
+    const char* const PATH = "Test_MappedFileStore.tmp";
+
+    // Writes the pattern used by these tests and returns it.
+    std::vector<uint8_t> writeFile(size_t size) {
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = static_cast<uint8_t>(i * 7);
+        }
+        std::FILE* file = std::fopen(PATH, "wb");
+        REQUIRE(file);
+        REQUIRE(std::fwrite(data.data(), 1, size, file) == size);
+        std::fclose(file);
+        return data;
+    }
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/MappedFileStore | Stores hold the file",
+        "[core][memory]") {
+    std::vector<uint8_t> data = writeFile(100000);
+
+    {
+        MappedFileStore store {PATH, MappedFileStore::READ_ONLY,
+                MappedFileStore::SEQUENTIAL, true};
+        REQUIRE(store.getRawStorage());
+        REQUIRE(store.SIZE == data.size());
+        REQUIRE(store.getMode() == MappedFileStore::READ_ONLY);
+        REQUIRE(libxaos::memory::isAligned(store.getRawStorage(),
+                store.ALIGNMENT));
+        REQUIRE(std::memcmp(store.getRawStorage(), data.data(),
+                data.size()) == 0);
+
+        // Hints never break anything.
+        store.advise(MappedFileStore::RANDOM);
+        store.prefetch(12345, 50000);
+        store.prefetch(99999, 50000);
+        store.prefetch(200000, 1);
+        REQUIRE(store.getRawStorage()[54321] == data[54321]);
+    }
+
+    std::remove(PATH);
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/MappedFileStore | Copy on write leaves the "
+        "file alone", "[core][memory]") {
+    std::vector<uint8_t> data = writeFile(5000);
+
+    {
+        MappedFileStore store {PATH, MappedFileStore::COPY_ON_WRITE};
+        REQUIRE(store.getRawStorage());
+        std::memset(store.getRawStorage(), 0xAB, store.SIZE);
+        REQUIRE(store.getRawStorage()[4999] == 0xAB);
+    }
+    {
+        MappedFileStore store {PATH};
+        REQUIRE(std::memcmp(store.getRawStorage(), data.data(),
+                data.size()) == 0);
+    }
+
+    std::remove(PATH);
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/MappedFileStore | Missing files are empty",
+        "[core][memory]") {
+    MappedFileStore store {"Test_MappedFileStore.missing"};
+    REQUIRE(store.getRawStorage() == nullptr);
+    REQUIRE(store.SIZE == 0);
+    store.prefetch(0, 100); // Ignored!
+}
@@ -0,0 +1,53 @@
+/**
+ *  @file Test_NumaStore.cpp
+ *  @brief Tests: libxaos-core:memory/store/impl/NumaStore.h
+ *
+ *  Creates NumaStores and verifies they hold data.  Whether the memory can
+ *  actually be bound depends on the machine (and any container it's in), so
+ *  either outcome is accepted.
+ */
+
+#include <cstdint>
+
+#include "memory/store/impl/NumaStore.h"
+#include "memory/utility/alignment.h"
+#include "memory/utility/numa.h"
+#include "memory/utility/pages.h"
+
+#include "catch.hpp"
+
+// Define some types
+using NumaStore = libxaos::memory::NumaStore;
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/NumaStore | Stores hold data",
+        "[core][memory]") {
+    size_t pageSize = libxaos::memory::getPageSize();
+    size_t node = libxaos::memory::getNumaNodeCount() - 1;
+    NumaStore store {pageSize + 1, node, true};
+
+    REQUIRE(store.getRawStorage());
+    REQUIRE(store.SIZE == 2 * pageSize); // Rounded up
+    REQUIRE(store.getNode() == node);
+    REQUIRE(libxaos::memory::isAligned(store.getRawStorage(),
+            store.ALIGNMENT));
+
+    uint8_t* storage = store.getRawStorage();
+    for (size_t i = 0; i < store.SIZE; i++) {
+        storage[i] = static_cast<uint8_t>(i);
+    }
+    for (size_t i = 0; i < store.SIZE; i++) {
+        REQUIRE(storage[i] == static_cast<uint8_t>(i));
+    }
+
+    INFO("Bound: " << store.isBound());
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/NumaStore | Missing nodes fall back",
+        "[core][memory]") {
+    NumaStore store {1, libxaos::memory::MAX_NUMA_NODES};
+
+    REQUIRE(store.getRawStorage());
+    REQUIRE(store.getNode() == 0);
+    store.getRawStorage()[0] = 42;
+    REQUIRE(store.getRawStorage()[0] == 42);
+}
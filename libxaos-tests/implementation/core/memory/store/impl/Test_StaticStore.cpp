@@ -67,7 +67,7 @@ TEST_CASE("CORE:MEMORY/STORE/IMPL/StaticStore | Stores hold data.",
 }
 
 TEST_CASE("CORE:MEMORY/STORE/IMPL/StaticStore | Stores are aligned.",
-        "[core][memory][!mayfail]") {
+        "[core][memory]") {
 
     // create our stores
     Store128 storeA {};
@@ -0,0 +1,81 @@
+/**
+ *  @file Test_VirtualStore.cpp
+ *  @brief Tests: libxaos-core:memory/store/impl/VirtualStore.h
+ *
+ *  Reserves VirtualStores, commits parts of them, and verifies that the
+ *  storage never moves while it grows.
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "memory/utility/alignment.h"
+#include "strings/PooledString.h"
+#include "strings/StringPool.h"
+
+#include "catch.hpp"
+
+// Define some types
+using VirtualStore = libxaos::memory::VirtualStore;
+using LinearAllocator = libxaos::memory::LinearAllocator;
+
+constexpr size_t RESERVE = 16 * 1024 * 1024;
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/VirtualStore | Can reserve and commit",
+        "[core][memory]") {
+    VirtualStore store {RESERVE};
+
+    REQUIRE(store.getRawStorage());
+    REQUIRE(store.SIZE >= RESERVE);
+    REQUIRE(store.getCommitted() == 0);
+    REQUIRE(libxaos::memory::isAligned(store.getRawStorage(),
+            store.ALIGNMENT));
+
+    uint8_t* storage = store.getRawStorage();
+    REQUIRE(store.commit(100));
+    REQUIRE(store.getCommitted() >= 100);
+    storage[99] = 42;
+
+    REQUIRE(store.commit(RESERVE / 2));
+    storage[RESERVE / 2 - 1] = 24;
+    REQUIRE(store.getRawStorage() == storage); // Never moves!
+    REQUIRE(storage[99] == 42);
+
+    REQUIRE(!store.commit(store.SIZE + 1));
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/VirtualStore | Can decommit",
+        "[core][memory]") {
+    VirtualStore store {RESERVE};
+
+    REQUIRE(store.commit(4096));
+    store.getRawStorage()[0] = 42;
+    store.decommit();
+    REQUIRE(store.getCommitted() == 0);
+
+    REQUIRE(store.commit(4096));
+    REQUIRE(store.getRawStorage()[0] == 0); // Fresh pages
+}
+
+TEST_CASE("CORE:MEMORY/STORE/IMPL/VirtualStore | Users grow the store",
+        "[core][memory]") {
+    LinearAllocator allocator {new VirtualStore(RESERVE)};
+
+    // Way more than a single growth step.
+    for (int i = 0; i < 1024; i++) {
+        uint8_t* block = static_cast<uint8_t*>(allocator.allocate(4096));
+        REQUIRE(block);
+        block[4095] = 1;
+    }
+
+    libxaos::strings::StringPool pool {new VirtualStore(RESERVE)};
+    char buffer[32];
+    libxaos::strings::PooledString first = pool.process("first");
+    for (int i = 0; i < 8192; i++) {
+        snprintf(buffer, sizeof(buffer), "string-%d", i);
+        REQUIRE(pool.process(buffer));
+    }
+    REQUIRE(pool.process("first") == first);
+}
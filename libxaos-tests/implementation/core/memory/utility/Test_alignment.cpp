@@ -0,0 +1,51 @@
+/**
+ *  @file Test_alignment.cpp
+ *  @brief Tests: libxaos-core:memory/utility/alignment.h
+ *
+ *  Tests the alignment helpers on both sizes and pointers.
+ */
+
+#include <cstdint>
+
+#include "memory/utility/alignment.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::memory;
+
+// These should all be usable at compile time.
+static_assert(isPowerOfTwo(SIMD_ALIGNMENT), "SIMD_ALIGNMENT is broken!");
+static_assert(isPowerOfTwo(CACHE_LINE_SIZE), "CACHE_LINE_SIZE is broken!");
+static_assert(alignUp(17, 16) == 32, "alignUp isn't constexpr!");
+
+TEST_CASE("CORE:MEMORY/UTILITY/alignment | Can align sizes", "[core][memory]") {
+    REQUIRE(isPowerOfTwo(1));
+    REQUIRE(isPowerOfTwo(64));
+    REQUIRE(!isPowerOfTwo(0));
+    REQUIRE(!isPowerOfTwo(48));
+
+    REQUIRE(alignUp(0, 16) == 0);
+    REQUIRE(alignUp(1, 16) == 16);
+    REQUIRE(alignUp(16, 16) == 16);
+    REQUIRE(alignDown(31, 16) == 16);
+    REQUIRE(alignDown(32, 16) == 32);
+    REQUIRE(isAligned(64, 64));
+    REQUIRE(!isAligned(65, 64));
+}
+
+TEST_CASE("CORE:MEMORY/UTILITY/alignment | Can align pointers",
+        "[core][memory]") {
+    alignas(64) uint8_t buffer[128] {};
+
+    uint8_t* unaligned = buffer + 3;
+    uint8_t* up = alignUp(unaligned, 16);
+    uint8_t* down = alignDown(unaligned, 16);
+
+    REQUIRE(isAligned(buffer, 64));
+    REQUIRE(!isAligned(unaligned, 16));
+    REQUIRE(up == buffer + 16);
+    REQUIRE(down == buffer);
+    REQUIRE(getAlignmentOffset(unaligned, 16) == 13);
+    REQUIRE(getAlignmentOffset(up, 16) == 0);
+}
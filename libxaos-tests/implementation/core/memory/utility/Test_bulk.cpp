@@ -0,0 +1,90 @@
+/**
+ *  @file Test_bulk.cpp
+ *  @brief Tests: libxaos-core:memory/utility/bulk.h
+ *
+ *  Runs the bulk kernels on either side of STREAMING_THRESHOLD (and at odd
+ *  offsets, so the head and tail paths are used) and checks them against
+ *  the plain routines.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "memory/utility/bulk.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::memory;
+
+namespace {
+    // Sizes covering both paths, with awkward remainders.
+    const size_t SIZES[] = {0, 1, 100, STREAMING_THRESHOLD - 1,
+            STREAMING_THRESHOLD, STREAMING_THRESHOLD * 4 + 77};
+    // Offsets that knock pointers off any natural alignment.
+    const size_t OFFSETS[] = {0, 1, 13, 31};
+    const size_t PADDING = 64;
+}
+
+TEST_CASE("CORE:MEMORY/UTILITY/bulk | Can copy, fill and zero",
+        "[core][memory]") {
+    INFO("Kernel: " << getBulkKernel());
+
+    for (size_t size : SIZES) {
+        std::vector<uint8_t> source(size + PADDING);
+        for (size_t i = 0; i < source.size(); i++) {
+            source[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+
+        for (size_t offset : OFFSETS) {
+            std::vector<uint8_t> destination(size + PADDING, 0xEE);
+            bulkCopy(destination.data() + offset, source.data() + 3, size);
+            REQUIRE(std::memcmp(destination.data() + offset,
+                    source.data() + 3, size) == 0);
+            REQUIRE(destination[offset + size] == 0xEE); // Not past the end.
+            if (offset != 0)
+                REQUIRE(destination[offset - 1] == 0xEE);
+
+            bulkFill(destination.data() + offset, 0x5A, size);
+            for (size_t i = 0; i < size; i++) {
+                if (destination[offset + i] != 0x5A)
+                    FAIL("Fill missed byte " << i << " of " << size);
+            }
+            REQUIRE(destination[offset + size] == 0xEE);
+
+            bulkZero(destination.data() + offset, size);
+            for (size_t i = 0; i < size; i++) {
+                if (destination[offset + i] != 0)
+                    FAIL("Zero missed byte " << i << " of " << size);
+            }
+            REQUIRE(destination[offset + size] == 0xEE);
+        }
+    }
+}
+
+TEST_CASE("CORE:MEMORY/UTILITY/bulk | Can compare", "[core][memory]") {
+    for (size_t size : SIZES) {
+        std::vector<uint8_t> left(size + PADDING, 0x40);
+        std::vector<uint8_t> right(size + PADDING, 0x40);
+
+        for (size_t offset : OFFSETS) {
+            REQUIRE(bulkCompare(left.data() + offset, right.data(),
+                    size) == 0);
+        }
+        if (size == 0)
+            continue;
+
+        // Differences at the start, middle and end are all found, and the
+        // sign matches memcmp's.
+        const size_t positions[] = {0, size / 2, size - 1};
+        for (size_t position : positions) {
+            right[position] = 0x41;
+            REQUIRE(bulkCompare(left.data(), right.data(), size) < 0);
+            REQUIRE(bulkCompare(right.data(), left.data(), size) > 0);
+            REQUIRE((bulkCompare(left.data() + 1, right.data() + 1,
+                    size - 1) == 0) == (position == 0));
+            right[position] = 0x40;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ *  @file Test_tracking.cpp
+ *  @brief Tests: libxaos-core:memory/utility/tracking.h
+ *
+ *  Tags a few allocators and verifies their usage is recorded.  (When
+ *  tracking is compiled out, verifies nothing is.)
+ */
+
+#include <string>
+
+#include "memory/allocator/impl/LinearAllocator.h"
+#include "memory/allocator/impl/PoolAllocator.h"
+#include "memory/store/impl/StaticStore.h"
+#include "memory/utility/tracking.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::memory;
+
+// Define some types
+using Store = StaticStore<256, 16, 3>;
+
+TEST_CASE("CORE:MEMORY/UTILITY/tracking | Can register tags",
+        "[core][memory]") {
+    MemoryTag physics = registerMemoryTag("test-physics");
+    MemoryTag audio = registerMemoryTag("test-audio");
+
+    REQUIRE(physics != MEMORY_TAG_UNTAGGED);
+    REQUIRE(audio != MEMORY_TAG_UNTAGGED);
+    REQUIRE(physics != audio);
+    REQUIRE(registerMemoryTag("test-physics") == physics);
+    REQUIRE(getMemoryTagCount() > audio);
+
+    MemoryTagStatistics statistics = getMemoryTagStatistics(physics);
+    REQUIRE(std::string(statistics.name) == "test-physics");
+    REQUIRE(std::string(getMemoryTagStatistics(MEMORY_TAG_UNTAGGED).name)
+            == "untagged");
+}
+
+TEST_CASE("CORE:MEMORY/UTILITY/tracking | Records tagged allocators",
+        "[core][memory]") {
+    MemoryTag tag = registerMemoryTag("test-tracking");
+    setMemoryBudget(tag, 128);
+    MemoryTagStatistics before = getMemoryTagStatistics(tag);
+
+    {
+        LinearAllocator linear {new Store()};
+        PoolAllocator<32, 16> pool {new Store()};
+        linear.setMemoryTag(tag);
+        pool.setMemoryTag(tag);
+        REQUIRE(linear.getMemoryTag() == tag);
+
+        LinearAllocator::Marker marker = linear.getMarker();
+        REQUIRE(linear.allocate(64, 16));
+        REQUIRE(linear.allocate(64, 16));
+        void* block = pool.allocate();
+        REQUIRE(block);
+        REQUIRE(linear.allocate(1024) == nullptr);
+
+        MemoryTagStatistics during = getMemoryTagStatistics(tag);
+        if (MEMORY_TRACKING_ENABLED) {
+            REQUIRE(during.liveBytes - before.liveBytes == 64 + 64 + 32);
+            REQUIRE(during.allocationCount - before.allocationCount == 3);
+            REQUIRE(during.failureCount - before.failureCount == 1);
+            REQUIRE(during.overBudget);
+        } else {
+            REQUIRE(during.liveBytes == 0);
+            REQUIRE(during.allocationCount == 0);
+            REQUIRE_FALSE(during.overBudget);
+        }
+
+        // Rewinding frees bytes, but isn't a deallocation.
+        linear.rewind(marker);
+        pool.deallocate(block);
+        MemoryTagStatistics after = getMemoryTagStatistics(tag);
+        REQUIRE(after.liveBytes == before.liveBytes);
+        REQUIRE(after.peakBytes >= during.liveBytes);
+        if (MEMORY_TRACKING_ENABLED)
+            REQUIRE(after.deallocationCount - before.deallocationCount == 1);
+
+        // The per frame counters roll over on tick.
+        tickMemoryFrame();
+        if (MEMORY_TRACKING_ENABLED) {
+            REQUIRE(getMemoryTagStatistics(tag).frameAllocationCount >= 3);
+        }
+        tickMemoryFrame();
+        REQUIRE(getMemoryTagStatistics(tag).frameAllocationCount == 0);
+        REQUIRE(getMemoryTagStatistics(tag).frameAllocatedBytes == 0);
+
+        linear.allocate(16);
+    }
+
+    // Destroying an allocator releases what's left in it.
+    REQUIRE(getMemoryTagStatistics(tag).liveBytes == before.liveBytes);
+}
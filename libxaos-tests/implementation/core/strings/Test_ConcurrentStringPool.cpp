@@ -0,0 +1,112 @@
+/**
+ *  @file Test_ConcurrentStringPool.cpp
+ *  @brief Tests: libxaos-core:strings/ConcurrentStringPool.h
+ *
+ *  Has several threads intern overlapping sets of strings at once and checks
+ *  they all agree on a single PooledString for each.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "memory/store/impl/StaticStore.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "strings/ConcurrentStringPool.h"
+#include "strings/PooledString.h"
+
+#include "catch.hpp"
+
+// Define a few types
+using IndexStore = libxaos::memory::StaticStore<16 * 1024, 16, 15>;
+using VirtualStore = libxaos::memory::VirtualStore;
+using ConcurrentStringPool = libxaos::strings::ConcurrentStringPool;
+using PooledString = libxaos::strings::PooledString;
+
+TEST_CASE("CORE:STRINGS/ConcurrentStringPool | Can Add Strings to Pool",
+        "[core]") {
+    ConcurrentStringPool pool {new VirtualStore(1024 * 1024)};
+
+    PooledString string = pool.process("I am now pooled.");
+    REQUIRE(string);
+    REQUIRE(strcmp(string.getCharPointer(), "I am now pooled.") == 0);
+    REQUIRE(pool.process("I am now pooled.") == string);
+    REQUIRE(pool.contains("I am now pooled."));
+    REQUIRE(pool.contains(string));
+    REQUIRE(!pool.contains("I am not."));
+    REQUIRE(!pool.contains(PooledString {nullptr}));
+    REQUIRE(pool.getCount() == 1);
+}
+
+TEST_CASE("CORE:STRINGS/ConcurrentStringPool | Threads Agree On Strings",
+        "[core]") {
+    ConcurrentStringPool pool {new VirtualStore(16 * 1024 * 1024)};
+
+    // Every thread interns the same strings, each in a different order.
+    const int THREADS = 8;
+    const int STRINGS = 5000;
+    std::vector<std::vector<PooledString>> results(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&pool, &results, t]() {
+            std::vector<PooledString>& mine = results[t];
+            mine.assign(STRINGS, PooledString {nullptr});
+            char buffer[32];
+            for (int n = 0; n < STRINGS; n++) {
+                int i = (n * 7919 + t * 997) % STRINGS;
+                snprintf(buffer, sizeof(buffer), "asset/%d", i);
+                mine[i] = pool.process(buffer);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(pool.getCount() == STRINGS);
+    char buffer[32];
+    for (int i = 0; i < STRINGS; i++) {
+        snprintf(buffer, sizeof(buffer), "asset/%d", i);
+        REQUIRE(results[0][i]);
+        REQUIRE(strcmp(results[0][i].getCharPointer(), buffer) == 0);
+        for (int t = 1; t < THREADS; t++) {
+            if (results[t][i] != results[0][i])
+                FAIL("Thread " << t << " got its own copy of " << buffer);
+        }
+    }
+}
+
+TEST_CASE("CORE:STRINGS/ConcurrentStringPool | Pool Handles A Full Index "
+        "Gracefully", "[core]") {
+    ConcurrentStringPool pool {new VirtualStore(1024 * 1024),
+            new IndexStore()};
+
+    // Each shard has a few dozen slots; fill them all.
+    char buffer[32];
+    size_t added = 0;
+    for (int i = 0; i < 5000; i++) {
+        snprintf(buffer, sizeof(buffer), "name_%d", i);
+        if (pool.process(buffer))
+            added++;
+    }
+    REQUIRE(added == pool.getCount());
+    REQUIRE(added > 100);
+    REQUIRE(added < 5000);
+}
+
+TEST_CASE("CORE:STRINGS/ConcurrentStringPool | Provided Index Stores Are "
+        "Cleared", "[core]") {
+    // Leave garbage behind (as a previous user of the store might).
+    IndexStore* index = new IndexStore();
+    memset(index->getRawStorage(), 0xFF, index->SIZE);
+
+    ConcurrentStringPool pool {new VirtualStore(1024 * 1024), index};
+    REQUIRE(pool.getCount() == 0);
+    REQUIRE(!pool.contains("Not here."));
+
+    PooledString string = pool.process("Now here.");
+    REQUIRE(string);
+    REQUIRE(pool.contains("Now here."));
+    REQUIRE(pool.getCount() == 1);
+}
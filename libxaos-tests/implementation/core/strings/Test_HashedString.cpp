@@ -64,3 +64,71 @@ TEST_CASE("CORE:STRINGS/HashedString | Can Compare HashedStrings", "[core]") {
     REQUIRE(hashB == HashedString::NULL_STRING_HASH);
     REQUIRE(HashedString::NULL_STRING_HASH != hashA);
 }
+
+// The literal is usable at compile time...
+using namespace libxaos::strings::literals;
+static_assert("jump"_hs == "jump"_hs, "_hs isn't constexpr!");
+static_assert("jump"_hs != "duck"_hs, "_hs isn't hashing!");
+static_assert(""_hs == HashedString::EMPTY_STRING_HASH, "_hs broke EMPTY!");
+static_assert(HashedString::hash(nullptr) == HashedString::NULL_STRING_HASH,
+        "hash() broke NULL!");
+
+TEST_CASE("CORE:STRINGS/HashedString | Compile-time hashes match runtime "
+        "hashes", "[core]") {
+    // ...and matches the runtime hash.
+    REQUIRE("STRING"_hs == HashedString {"STRING"});
+    REQUIRE(""_hs == HashedString::EMPTY_STRING);
+    REQUIRE(HashedString::hash(nullptr) == HashedString::NULL_STRING);
+    REQUIRE(HashedString::hash("A much longer string, with punctuation!") ==
+            HashedString {"A much longer string, with punctuation!"});
+
+    // High characters are hashed as unsigned in both.
+    const char* high = "\xC3\xA9t\xC3\xA9";
+    REQUIRE(HashedString::hash(high) == HashedString {high});
+
+    // Every short string agrees, including whatever lands on the reserved
+    // values.
+    char buffer[3] = {0, 0, 0};
+    for (int a = 1; a < 256; a++) {
+        buffer[0] = static_cast<char>(a);
+        for (int b = 0; b < 256; b += 17) {
+            buffer[1] = static_cast<char>(b);
+            if (HashedString::hash(buffer) != HashedString {buffer})
+                FAIL("Hashes differ for " << a << ", " << b);
+        }
+    }
+
+    // Usable as case labels.
+    HashedString event {"duck"};
+    int matched = 0;
+    switch (event.getHash()) {
+        case "jump"_hs.getHash():
+            matched = 1;
+            break;
+        case "duck"_hs.getHash():
+            matched = 2;
+            break;
+        default:
+            break;
+    }
+    REQUIRE(matched == 2);
+}
+
+TEST_CASE("CORE:STRINGS/HashedString | Wide hashes keep djb2 collisions "
+        "apart", "[core]") {
+    // Raising one character by one and lowering the next by 33 collides
+    // under djb2 (hash * 33 + c); FNV-1a doesn't have that structure.
+    HashedString a {"collide/aB"};
+    HashedString b {"collide/b!"};
+    REQUIRE(HashedString::hash("collide/aB") == a);
+    REQUIRE(HashedString::hash("collide/b!") == b);
+
+    #ifdef LIBXAOS_FLAG_WIDE_HASHES
+        REQUIRE(a != b);
+        REQUIRE(HashedString {"a"} == 0xAF63DC4C8601EC8CULL);
+        REQUIRE(HashedString {"foobar"} == 0x85944171F73967E8ULL);
+    #else
+        REQUIRE(a == b);
+        REQUIRE(HashedString {"a"} == 5381U * 33U + 'a');
+    #endif
+}
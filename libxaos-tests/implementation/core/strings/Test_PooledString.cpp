@@ -7,9 +7,16 @@
  *  constructs simultaneously given their entanglement and function.
  */
 
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <string>
+#include <vector>
 
+#include "memory/store/impl/MappedFileStore.h"
 #include "memory/store/impl/StaticStore.h"
+#include "memory/store/impl/VirtualStore.h"
+#include "strings/HashedString.h"
 #include "strings/StringPool.h"
 #include "strings/PooledString.h"
 
@@ -19,6 +26,7 @@
 using Store = libxaos::memory::StaticStore<1024, 4, 0>;
 using StringPool = libxaos::strings::StringPool;
 using PooledString = libxaos::strings::PooledString;
+using HashedString = libxaos::strings::HashedString;
 
 TEST_CASE("CORE:STRINGS/StringPool | Can Create StringPools", "[core]") {
     Store* store = new Store();
@@ -124,3 +132,263 @@ TEST_CASE("CORE:STRINGS/StringPool | Pool Handles Filling Up Gracefully",
     REQUIRE(addedString != nullptr);
     REQUIRE(failAdd2 == nullptr);
 }
+
+TEST_CASE("CORE:STRINGS/StringPool | Pool Finds Strings Among Many", "[core]") {
+    using BigStore = libxaos::memory::StaticStore<64 * 1024, 16, 12>;
+    StringPool pool {new BigStore()};
+
+    char buffer[32];
+    std::vector<PooledString> strings;
+    for (int i = 0; i < 2000; i++) {
+        snprintf(buffer, sizeof(buffer), "identifier_%d", i);
+        PooledString string = pool.process(buffer);
+        REQUIRE(string);
+        strings.push_back(string);
+    }
+
+    // Every string is found again (and only once).
+    for (int i = 0; i < 2000; i++) {
+        snprintf(buffer, sizeof(buffer), "identifier_%d", i);
+        REQUIRE(pool.contains(buffer));
+        REQUIRE(pool.process(buffer) == strings[i]);
+        REQUIRE(strcmp(strings[i].getCharPointer(), buffer) == 0);
+    }
+    REQUIRE(!pool.contains("identifier_2000"));
+    REQUIRE(!pool.contains("identifier_"));
+    REQUIRE(!pool.contains(""));
+}
+
+TEST_CASE("CORE:STRINGS/StringPool | Pool Handles A Full Index Gracefully",
+        "[core]") {
+    using StringStore = libxaos::memory::StaticStore<64 * 1024, 16, 13>;
+    using IndexStore = libxaos::memory::StaticStore<1024, 16, 14>;
+    StringPool pool {new StringStore(), new IndexStore()};
+
+    // The index store only has room for a few dozen slots.
+    char buffer[32];
+    int added = 0;
+    for (int i = 0; i < 200; i++) {
+        snprintf(buffer, sizeof(buffer), "name_%d", i);
+        if (!pool.process(buffer))
+            break;
+        added++;
+    }
+    REQUIRE(added > 32);
+    REQUIRE(added < 200);
+
+    // What made it in is still there.
+    for (int i = 0; i < added; i++) {
+        snprintf(buffer, sizeof(buffer), "name_%d", i);
+        REQUIRE(pool.contains(buffer));
+        REQUIRE(pool.process(buffer));
+    }
+}
+
+TEST_CASE("CORE:STRINGS/StringPool | Pool Chains Stores When Full",
+        "[core]") {
+    using SmallStore = libxaos::memory::StaticStore<256, 4, 16>;
+    StringPool pool {new SmallStore()};
+    size_t created = 0;
+    size_t growth = 1024;
+    pool.setStoreFactory([&created, growth](size_t size) ->
+            libxaos::memory::IStore* {
+        created++;
+        return new libxaos::memory::VirtualStore(size < growth ? growth :
+                size);
+    });
+    REQUIRE(pool.getStoreFactory());
+
+    // Far more than the first store holds.
+    char buffer[32];
+    std::vector<PooledString> strings;
+    for (int i = 0; i < 500; i++) {
+        snprintf(buffer, sizeof(buffer), "chained_%d", i);
+        PooledString string = pool.process(buffer);
+        REQUIRE(string);
+        strings.push_back(string);
+    }
+    REQUIRE(pool.getStoreCount() > 1);
+    REQUIRE(pool.getStoreCount() <= StringPool::MAX_STORES);
+    REQUIRE(created == pool.getStoreCount() - 1);
+
+    // Bigger than anything the factory makes by default.
+    std::vector<char> large(4000, 'L');
+    large.back() = '\0';
+    PooledString largeString = pool.process(large.data());
+    REQUIRE(largeString);
+    REQUIRE(largeString.length() == 3999);
+
+    // Nothing moved.
+    for (int i = 0; i < 500; i++) {
+        snprintf(buffer, sizeof(buffer), "chained_%d", i);
+        REQUIRE(pool.process(buffer) == strings[i]);
+        REQUIRE(strcmp(strings[i].getCharPointer(), buffer) == 0);
+    }
+    REQUIRE(pool.process(large.data()) == largeString);
+
+    // Without a factory, a full pool refuses strings as before.
+    pool.setStoreFactory(nullptr);
+    REQUIRE(!pool.getStoreFactory());
+    REQUIRE(!pool.process(large.data() + 1));
+    REQUIRE(pool.process("chained_0") == strings[0]);
+}
+
+TEST_CASE("CORE:STRINGS/StringPool | Pools Can Be Opened From Images",
+        "[core]") {
+    using libxaos::memory::MappedFileStore;
+    using libxaos::memory::VirtualStore;
+    const char* const PATH = "Test_StringPoolImage.tmp";
+    char buffer[32];
+
+    // Bake an image of a chained pool and write it out.
+    {
+        StringPool pool {new VirtualStore(1024)};
+        pool.setStoreFactory([](size_t) -> libxaos::memory::IStore* {
+            return new VirtualStore(4096);
+        });
+        for (int i = 0; i < 1000; i++) {
+            snprintf(buffer, sizeof(buffer), "baked_%d", i);
+            REQUIRE(pool.process(buffer));
+        }
+        REQUIRE(pool.getStoreCount() > 1);
+
+        std::vector<uint64_t> image((pool.getImageSize() + 7) / 8);
+        size_t size = pool.writeImage(image.data(), image.size() * 8);
+        REQUIRE(size == pool.getImageSize());
+        REQUIRE(pool.writeImage(image.data(), size - 1) == 0);
+
+        std::FILE* file = std::fopen(PATH, "wb");
+        REQUIRE(file);
+        REQUIRE(std::fwrite(image.data(), 1, size, file) == size);
+        std::fclose(file);
+    }
+
+    MappedFileStore* mapped = new MappedFileStore(PATH);
+    const char* begin = reinterpret_cast<const char*>(
+            mapped->getRawStorage());
+    const char* end = begin + mapped->SIZE;
+    StringPool pool = StringPool::openImage(mapped,
+            new VirtualStore(64 * 1024));
+    REQUIRE(pool.hasImage());
+
+    // Baked strings come straight from the file.
+    for (int i = 0; i < 1000; i++) {
+        snprintf(buffer, sizeof(buffer), "baked_%d", i);
+        PooledString string = pool.process(buffer);
+        REQUIRE(string);
+        REQUIRE(string.getCharPointer() >= begin);
+        REQUIRE(string.getCharPointer() < end);
+        REQUIRE(strcmp(string.getCharPointer(), buffer) == 0);
+        REQUIRE(string.getHash() == HashedString(buffer).getHash());
+    }
+
+    // New ones go in the overflow store.
+    PooledString fresh = pool.process("fresh");
+    REQUIRE(fresh);
+    REQUIRE((fresh.getCharPointer() < begin ||
+            fresh.getCharPointer() >= end));
+    REQUIRE(pool.process("fresh") == fresh);
+    REQUIRE(pool.contains("baked_999"));
+    REQUIRE(pool.contains("fresh"));
+    REQUIRE(!pool.contains("baked_1000"));
+
+    // Images of image-backed pools hold both.
+    std::vector<uint64_t> image((pool.getImageSize() + 7) / 8);
+    REQUIRE(pool.writeImage(image.data(), image.size() * 8) > 0);
+    libxaos::memory::IStore* copy = new VirtualStore(image.size() * 8);
+    REQUIRE(copy->commit(image.size() * 8));
+    memcpy(copy->getRawStorage(), image.data(), image.size() * 8);
+    StringPool reopened = StringPool::openImage(copy);
+    REQUIRE(reopened.hasImage());
+    REQUIRE(reopened.contains("fresh"));
+    REQUIRE(reopened.contains("baked_0"));
+    REQUIRE(!reopened.process("not baked")); // No overflow store
+
+    std::remove(PATH);
+}
+
+TEST_CASE("CORE:STRINGS/StringPool | Pools Ignore Invalid Images", "[core]") {
+    using libxaos::memory::VirtualStore;
+    libxaos::memory::IStore* garbage = new VirtualStore(4096);
+    REQUIRE(garbage->commit(4096));
+    memset(garbage->getRawStorage(), 0x5A, 4096);
+
+    StringPool pool = StringPool::openImage(garbage, new Store());
+    REQUIRE(!pool.hasImage());
+    REQUIRE(pool.process("Still works"));
+    REQUIRE(pool.contains("Still works"));
+
+    StringPool empty = StringPool::openImage(nullptr);
+    REQUIRE(!empty.hasImage());
+    REQUIRE(!empty.process("Nowhere to go"));
+}
+
+TEST_CASE("CORE:STRINGS/StringPool | Pool Processes Many Strings At Once",
+        "[core]") {
+    using libxaos::memory::VirtualStore;
+    StringPool pool {new VirtualStore(1024 * 1024)};
+    PooledString existing = pool.process("batch_7");
+
+    // Plenty of repeats (within and across batches).
+    const size_t COUNT = 3000;
+    std::vector<std::string> names(COUNT);
+    std::vector<const char*> strings(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        names[i] = "batch_" + std::to_string(i % 1000);
+        strings[i] = names[i].c_str();
+    }
+
+    std::vector<PooledString> results(COUNT, PooledString {nullptr});
+    REQUIRE(pool.process(strings.data(), COUNT, results.data()) == COUNT);
+    REQUIRE(results[7] == existing);
+    for (size_t i = 0; i < COUNT; i++) {
+        REQUIRE(strcmp(results[i].getCharPointer(), strings[i]) == 0);
+        REQUIRE(results[i] == results[i % 1000]);
+        REQUIRE(pool.process(strings[i]) == results[i]);
+    }
+    REQUIRE(pool.process(strings.data(), 0, nullptr) == 0);
+}
+
+TEST_CASE("CORE:STRINGS/StringPool | Pool Processes Many Strings Into A Full "
+        "Store", "[core]") {
+    using SmallStore = libxaos::memory::StaticStore<256, 4, 17>;
+    StringPool pool {new SmallStore()};
+
+    // Only the first few fit; the rest come back null.
+    const char* strings[40];
+    std::vector<std::string> names(40);
+    for (size_t i = 0; i < 40; i++) {
+        names[i] = "overflowing_" + std::to_string(i);
+        strings[i] = names[i].c_str();
+    }
+    std::vector<PooledString> results(40, PooledString {nullptr});
+    size_t pooled = pool.process(strings, 40, results.data());
+    REQUIRE(pooled > 0);
+    REQUIRE(pooled < 40);
+    for (size_t i = 0; i < 40; i++) {
+        REQUIRE(bool(results[i]) == (i < pooled));
+    }
+}
+
+TEST_CASE("CORE:STRINGS/PooledString | PooledStrings Know Their Length And "
+        "Hash", "[core]") {
+    Store* store = new Store();
+
+    StringPool pool {store}; // acquires ownership
+    pool.process("x"); // Knock the next entry off any natural alignment
+    PooledString string = pool.process("Metadata!");
+    PooledString nullString = nullptr;
+
+    REQUIRE(string.length() == 9);
+    REQUIRE(string.getHash() == HashedString("Metadata!").getHash());
+    REQUIRE(HashedString(string) == HashedString("Metadata!"));
+    REQUIRE(pool.process("x").length() == 1);
+
+    REQUIRE(nullString.length() == 0);
+    REQUIRE(nullString.getHash() == HashedString::NULL_STRING_HASH);
+
+    #if __cplusplus >= 201703L
+        REQUIRE(string.getView() == "Metadata!");
+        REQUIRE(nullString.getView().empty());
+    #endif
+}
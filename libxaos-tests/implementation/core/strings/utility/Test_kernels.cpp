@@ -0,0 +1,117 @@
+/**
+ *  @file Test_kernels.cpp
+ *  @brief Tests: libxaos-core:strings/utility/kernels.h
+ *
+ *  Runs the string kernels over many lengths (and at odd offsets, so every
+ *  block and tail path is used) and checks them against the byte-at-a-time
+ *  routines.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "memory/store/impl/VirtualStore.h"
+#include "strings/HashedString.h"
+#include "strings/utility/kernels.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::strings;
+
+namespace {
+    // djb2 (or FNV-1a for wide hashes) one character at a time.
+    HashType referenceHash(const char* str, size_t length, HashType hash) {
+        for (size_t i = 0; i < length; i++) {
+            #ifdef LIBXAOS_FLAG_WIDE_HASHES
+                hash = (hash ^ static_cast<unsigned char>(str[i])) *
+                        HashedString::HASH_MULTIPLIER;
+            #else
+                hash = static_cast<HashType>(hash * 33U +
+                        static_cast<unsigned char>(str[i]));
+            #endif
+        }
+        return hash;
+    }
+
+    // Non-zero characters, including high ones.
+    std::vector<char> makeCharacters(size_t size) {
+        std::vector<char> characters(size);
+        for (size_t i = 0; i < size; i++) {
+            characters[i] = static_cast<char>(i * 37 % 255 + 1);
+        }
+        return characters;
+    }
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/kernels | Lengths match strlen", "[core]") {
+    INFO("Kernel: " << getStringKernel());
+
+    std::vector<char> characters = makeCharacters(200);
+    for (size_t offset = 0; offset < 32; offset++) {
+        for (size_t length = 0; length < 150; length++) {
+            char saved = characters[offset + length];
+            characters[offset + length] = '\0';
+            if (stringLength(characters.data() + offset) != length)
+                FAIL("Wrong length " << length << " at offset " << offset);
+            characters[offset + length] = saved;
+        }
+    }
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/kernels | Lengths stop at the end of a page",
+        "[core]") {
+    // Only the first page is backed; touching the second would crash.
+    libxaos::memory::VirtualStore store {2 * 64 * 1024};
+    REQUIRE(store.commit(1));
+    size_t committed = store.getCommitted();
+    REQUIRE(committed < store.SIZE);
+
+    char* end = reinterpret_cast<char*>(store.getRawStorage()) + committed;
+    for (size_t length = 0; length < 70; length++) {
+        char* str = end - length - 1;
+        memset(str, 'x', length);
+        str[length] = '\0';
+        REQUIRE(stringLength(str) == length);
+    }
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/kernels | Equality matches memcmp", "[core]") {
+    std::vector<char> left = makeCharacters(200);
+    std::vector<char> right = left;
+
+    for (size_t length = 0; length < 150; length++) {
+        REQUIRE(stringsEqual(left.data(), right.data(), length));
+        REQUIRE(stringsEqual(left.data() + 3, right.data() + 3, length));
+
+        // A difference anywhere in range is found; past it, ignored.
+        for (size_t position = 0; position <= length; position++) {
+            right[position] ^= 0x40;
+            if (stringsEqual(left.data(), right.data(), length) !=
+                    (position == length))
+                FAIL("Missed a difference at " << position << " of "
+                        << length);
+            right[position] ^= 0x40;
+        }
+    }
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/kernels | Hashes match the reference",
+        "[core]") {
+    std::vector<char> characters = makeCharacters(300);
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length < 260; length++) {
+            const char* str = characters.data() + offset;
+            if (hashRange(str, length, HashedString::HASH_SEED) !=
+                    referenceHash(str, length, HashedString::HASH_SEED))
+                FAIL("Hashes differ for length " << length);
+        }
+    }
+
+    // And so HashedString still matches its compile-time hash.
+    const char* LONG = "a fairly long identifier/with/a/path/in/it.and.ext";
+    REQUIRE(HashedString {LONG} == HashedString::hash(LONG));
+    REQUIRE(HashedString(LONG, strlen(LONG)) == HashedString {LONG});
+    REQUIRE(HashedString(LONG, 0) == HashedString::EMPTY_STRING);
+}
@@ -0,0 +1,115 @@
+/**
+ *  @file Test_registry.cpp
+ *  @brief Tests: libxaos-core:strings/utility/registry.h
+ *
+ *  Hashes strings that do (and don't) collide and checks the registry notices
+ *  and can find them again.  Without LIBXAOS_FLAG_HASH_REGISTRY only the
+ *  empty behaviour is checked.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "strings/HashedString.h"
+#include "strings/utility/registry.h"
+
+#include "catch.hpp"
+
+// Use a namespace
+using namespace libxaos::strings;
+
+namespace {
+    // djb2 is hash * 33 + c, so raising one character by one and lowering
+    // the next by 33 lands on the same hash.  (Wide hashes use FNV-1a,
+    // which keeps these apart.)
+    const char* const COLLIDING_A = "registry/aB";
+    const char* const COLLIDING_B = "registry/b!";
+
+    HashType collidingHash = 0;
+    std::string collidingFirst {};
+    std::string collidingSecond {};
+
+    void onCollision(HashType hash, const char* first, const char* second) {
+        collidingHash = hash;
+        collidingFirst = first;
+        collidingSecond = second;
+    }
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/registry | Can look strings up by hash",
+        "[core]") {
+    HashedString hashed {"registry/lookup"};
+    const char* found = lookupHashedString(hashed.getHash());
+
+    if (!HASH_REGISTRY_ENABLED) {
+        REQUIRE(found == nullptr);
+        REQUIRE(getHashedStringCount() == 0);
+        return;
+    }
+
+    REQUIRE(found);
+    REQUIRE(strcmp(found, "registry/lookup") == 0);
+    REQUIRE(getHashedStringCount() > 0);
+
+    // Hashing it again isn't a collision.
+    size_t collisions = getHashCollisionCount();
+    HashedString again {std::string {"registry/lookup"}};
+    REQUIRE(again == hashed);
+    REQUIRE(getHashCollisionCount() == collisions);
+    REQUIRE(lookupHashedString(HashedString::NULL_STRING_HASH) == nullptr);
+    REQUIRE(lookupHashedString(HashedString::EMPTY_STRING_HASH) == nullptr);
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/registry | Collisions are caught", "[core]") {
+    size_t collisions = getHashCollisionCount();
+    setHashCollisionHandler(onCollision);
+    HashedString a {COLLIDING_A};
+    HashedString b {COLLIDING_B};
+    setHashCollisionHandler(nullptr);
+
+    if (sizeof(HashType) != sizeof(uint32_t)) {
+        REQUIRE(a != b);
+        REQUIRE(getHashCollisionCount() == collisions);
+        return;
+    }
+
+    REQUIRE(a == b); // The whole problem!
+    if (!HASH_REGISTRY_ENABLED) {
+        REQUIRE(getHashCollisionCount() == 0);
+        return;
+    }
+
+    REQUIRE(getHashCollisionCount() == collisions + 1);
+    REQUIRE(collidingHash == a.getHash());
+    REQUIRE(collidingFirst == COLLIDING_A);
+    REQUIRE(collidingSecond == COLLIDING_B);
+
+    // The first string keeps the hash.
+    REQUIRE(strcmp(lookupHashedString(a.getHash()), COLLIDING_A) == 0);
+}
+
+TEST_CASE("CORE:STRINGS/UTILITY/registry | Threads can record at once",
+        "[core]") {
+    const int THREADS = 4;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; i++) {
+                HashedString {"registry/thread/" + std::to_string(i)};
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const char* found = lookupHashedString(
+            HashedString {"registry/thread/999"}.getHash());
+    if (HASH_REGISTRY_ENABLED)
+        REQUIRE((found && strcmp(found, "registry/thread/999") == 0));
+    else
+        REQUIRE(found == nullptr);
+}